@@ -0,0 +1,91 @@
+#!/bin/bash
+#
+# Scanner benchmark: cminus_cimpl (scan.c), cminus_dfa (scandfa.c, the
+# DFA mkdfa generates) and cminus_lex (cminus.l)
+#
+# usage: ./bench.sh [-s megabytes] [-m mix] [-n runs] [-r seed]
+#
+# Generates a mixed input with mkbench (see mkbench.c for the mix
+# syntax) and one input per token kind, runs every engine with
+# TraceScan off and keeps the best of the runs. Reports MB/s and
+# tokens/s on the mixed input, and ns per item of each kind.
+# cminus_lex is skipped when flex is not installed (set FLEX to
+# use another flex binary).
+
+cd "$(dirname "$0")" || exit 1
+
+size=16
+mix="id=35,kw=10,num=15,op=25,relop=5,comment=5,ws=5"
+runs=3
+seed=1
+while getopts "s:m:n:r:" opt; do
+    case $opt in
+        s) size=$OPTARG ;;
+        m) mix=$OPTARG ;;
+        n) runs=$OPTARG ;;
+        r) seed=$OPTARG ;;
+        *) echo "usage: $0 [-s megabytes] [-m mix] [-n runs] [-r seed]" >&2; exit 1 ;;
+    esac
+done
+
+flex=${FLEX:-flex}
+make -s mkbench cminus_cimpl_bench cminus_dfa_bench || exit 1
+engines=(cminus_cimpl_bench cminus_dfa_bench)
+if command -v "${flex%% *}" > /dev/null 2>&1; then
+    if make -s FLEX="$flex" cminus_lex_bench; then
+        engines+=(cminus_lex_bench)
+    else
+        echo "cminus_lex: build failed, skipped"
+    fi
+else
+    echo "cminus_lex: skipped ($flex not found)"
+fi
+
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+# best ENGINE FILE: fastest of $runs runs, in nanoseconds
+best() {
+    local t0 t1 t min=
+    for ((i = 0; i < runs; i++)); do
+        t0=$(date +%s%N)
+        ./"$1" "$2" > /dev/null || return 1
+        t1=$(date +%s%N)
+        t=$((t1 - t0))
+        if [ -z "$min" ] || [ "$t" -lt "$min" ]; then min=$t; fi
+    done
+    echo "$min"
+}
+
+# gen FILE MIX: generate FILE and set bytes, tokens, items
+gen() {
+    local counts
+    counts=$(./mkbench -s "$size" -m "$2" -r "$seed" "$1") || exit 1
+    eval "$counts"
+}
+
+gen "$dir/mixed.cm" "$mix"
+echo
+echo "mixed input: $size MB, $tokens tokens ($mix), best of $runs"
+printf "%-20s %10s %12s %12s\n" engine seconds MB/s Mtokens/s
+for e in "${engines[@]}"; do
+    ns=$(best "$e" "$dir/mixed.cm") || { echo "$e: failed"; continue; }
+    awk -v e="${e%_bench}" -v ns="$ns" -v b="$bytes" -v t="$tokens" 'BEGIN {
+        s = ns / 1e9
+        printf "%-20s %10.3f %12.1f %12.2f\n", e, s, b / 1048576 / s, t / 1e6 / s }'
+done
+
+echo
+echo "per kind: ns per item on a $size MB input of that kind only"
+printf "%-10s" kind
+for e in "${engines[@]}"; do printf " %16s" "${e%_bench}"; done
+echo
+for k in id kw num op relop comment ws; do
+    gen "$dir/$k.cm" "$k=1"
+    printf "%-10s" "$k"
+    for e in "${engines[@]}"; do
+        ns=$(best "$e" "$dir/$k.cm") || { printf " %16s" failed; continue; }
+        awk -v ns="$ns" -v n="$items" 'BEGIN { printf " %16.2f", ns / n }'
+    done
+    echo
+done
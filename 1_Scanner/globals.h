@@ -84,6 +84,27 @@ extern int EchoSource;
  */
 extern int TraceScan;
 
+/* BinaryTrace = TRUE makes TraceScan write the
+ * tokens to the listing file as binary records (see
+ * tracebin.h) instead of text; trdump renders them
+ * back to the text listing. EchoSource must be off
+ */
+extern int BinaryTrace;
+
+/* BufferSource = TRUE causes the scanner to map (or
+ * read in one piece) the whole source file and lex
+ * it in place, instead of copying it in line by
+ * line with fgets
+ */
+extern int BufferSource;
+
+/* ParallelScan = TRUE lets the scanner split a large
+ * buffered source into chunks and lex them on
+ * several threads before handing out the tokens;
+ * the token stream is the same as a serial scan
+ */
+extern int ParallelScan;
+
 /* TraceParse = TRUE causes the syntax tree to be
  * printed to the listing file in linearized form
  * (using indents for children)
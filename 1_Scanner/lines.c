@@ -0,0 +1,68 @@
+/****************************************************/
+/* File: lines.c                                    */
+/* Newline index: line numbers from byte offsets    */
+/****************************************************/
+
+#include "globals.h"
+#include "lines.h"
+
+/* WALK = newlines lineOf steps over one by one before
+   it falls back to a binary search */
+#define WALK 8
+
+int buildLineIndex(LineIndex * li, const char * text, size_t len)
+{ const char * p = text, * end = text + len;
+  int capacity = len / 32 + 16;
+  li->nl = malloc(capacity * sizeof(unsigned));
+  li->count = 0;
+  li->cursor = 0;
+  li->first = 1; /* empty range: the first lookup searches */
+  li->last = 0;
+  if (li->nl == NULL) return FALSE;
+  while ((p = memchr(p,'\n',end - p)) != NULL)
+  { if (li->count == capacity)
+    { unsigned * bigger = realloc(li->nl,2 * capacity * sizeof(unsigned));
+      if (bigger == NULL)
+      { freeLineIndex(li);
+        return FALSE;
+      }
+      li->nl = bigger;
+      capacity *= 2;
+    }
+    li->nl[li->count++] = p++ - text;
+  }
+  return TRUE;
+}
+
+/* search finds the number of newlines before pos
+   among nl[lo..hi) */
+static int search(const unsigned * nl, int lo, int hi, size_t pos)
+{ while (lo < hi)
+  { int mid = lo + (hi - lo) / 2;
+    if (nl[mid] < pos) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+int lineOf(LineIndex * li, size_t pos)
+{ int i = li->cursor, stop = i + WALK;
+  if (i > 0 && li->nl[i-1] >= pos)
+    i = search(li->nl,0,i,pos);
+  else
+  { if (stop > li->count) stop = li->count;
+    while (i < stop && li->nl[i] < pos) i++;
+    if (i == stop && i < li->count && li->nl[i] < pos)
+      i = search(li->nl,i,li->count,pos);
+  }
+  li->cursor = i;
+  li->first = i > 0 ? li->nl[i-1] + 1 : 0;
+  li->last = i < li->count ? li->nl[i] : (size_t) -1;
+  return i + 1;
+}
+
+void freeLineIndex(LineIndex * li)
+{ free(li->nl);
+  li->nl = NULL;
+  li->count = li->cursor = 0;
+}
@@ -0,0 +1,43 @@
+/****************************************************/
+/* File: lines.h                                    */
+/* Newline index: line numbers from byte offsets    */
+/****************************************************/
+
+#ifndef _LINES_H_
+#define _LINES_H_
+
+/* LineIndex lists the offsets of every newline of a
+ * text, so the scanner can record plain offsets and
+ * turn one into a line number only when asked
+ */
+typedef struct
+   { unsigned * nl; /* offsets of the newlines, ascending */
+     int count;
+     int cursor; /* where the last lookup ended */
+     size_t first, last; /* offsets spanned by that line */
+   } LineIndex;
+
+/* Function buildLineIndex fills li with the newlines
+ * of the len bytes at text, in one memchr pass.
+ * Returns FALSE if out of memory
+ */
+int buildLineIndex( LineIndex * li, const char * text, size_t len );
+
+/* Function lineOf returns the line that holds offset
+ * pos: one plus the number of newlines before it.
+ * Lookups at or after the previous one walk forward
+ * from it; anything else is a binary search
+ */
+int lineOf( LineIndex * li, size_t pos );
+
+/* LINEOF is lineOf with the common case, pos on the
+ * same line as the previous lookup, done inline
+ */
+#define LINEOF(li,pos) \
+  ((pos) >= (li)->first && (pos) <= (li)->last ? (li)->cursor + 1 \
+                                               : lineOf((li),(pos)))
+
+/* Procedure freeLineIndex releases li */
+void freeLineIndex( LineIndex * li );
+
+#endif
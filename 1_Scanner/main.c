@@ -17,7 +17,37 @@
  */
 #define NO_CODE FALSE
 
+/* set TRACE_SCAN to FALSE to scan without listing
+ * the tokens (as the bench target does)
+ */
+#ifndef TRACE_SCAN
+#define TRACE_SCAN TRUE
+#endif
+
+/* set BINARY_TRACE to TRUE to list the tokens as a
+ * binary trace for trdump to render (as the
+ * cminus_cimpl_trace target does)
+ */
+#ifndef BINARY_TRACE
+#define BINARY_TRACE FALSE
+#endif
+
+/* set BUFFER_SOURCE to FALSE to read the source
+ * line by line through fgets
+ */
+#ifndef BUFFER_SOURCE
+#define BUFFER_SOURCE TRUE
+#endif
+
+/* set PARALLEL_SCAN to FALSE to always lex on one
+ * thread (it needs BUFFER_SOURCE)
+ */
+#ifndef PARALLEL_SCAN
+#define PARALLEL_SCAN TRUE
+#endif
+
 #include "util.h"
+#include "tracebin.h"
 #if NO_PARSE
 #include "scan.h"
 #else
@@ -38,7 +68,10 @@ FILE * code;
 
 /* allocate and set tracing flags */
 int EchoSource = FALSE;
-int TraceScan = TRUE;
+int TraceScan = TRACE_SCAN;
+int BinaryTrace = BINARY_TRACE;
+int BufferSource = BUFFER_SOURCE;
+int ParallelScan = PARALLEL_SCAN;
 int TraceParse = FALSE;
 int TraceAnalyze = FALSE;
 int TraceCode = FALSE;
@@ -47,21 +80,34 @@ int Error = FALSE;
 
 main( int argc, char * argv[] )
 { TreeNode * syntaxTree;
-  char pgm[120]; /* source code file name */
+  char * pgm; /* source code file name */
   if (argc != 2)
-    { fprintf(stderr,"usage: %s <filename>\n",argv[0]);
+    { fprintf(stderr,"usage: %s <filename>|-\n",argv[0]);
       exit(1);
     }
-  strcpy(pgm,argv[1]) ;
-  if (strchr (pgm, '.') == NULL)
-     strcat(pgm,".tny");
-  source = fopen(pgm,"r");
+  if (strcmp(argv[1],"-") == 0)
+  { /* read the program from standard input */
+    pgm = argv[1];
+    source = stdin;
+  }
+  else
+  { pgm = malloc(strlen(argv[1]) + 5);
+    if (pgm == NULL)
+    { fprintf(stderr,"Out of memory\n");
+      exit(1);
+    }
+    strcpy(pgm,argv[1]) ;
+    if (strchr (pgm, '.') == NULL)
+       strcat(pgm,".tny");
+    source = fopen(pgm,"r");
+  }
   if (source==NULL)
   { fprintf(stderr,"File %s not found\n",pgm);
     exit(1);
   }
   listing = stdout; /* send listing to screen */
-  fprintf(listing,"\nC-MINUS COMPILATION: %s\n",pgm);
+  if (TraceScan && BinaryTrace) traceStart(pgm);
+  else fprintf(listing,"\nC-MINUS COMPILATION: %s\n",pgm);
 #if NO_PARSE
   while (getToken()!=ENDFILE);
 #else
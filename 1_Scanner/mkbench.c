@@ -0,0 +1,188 @@
+/****************************************************/
+/* File: mkbench.c                                  */
+/* Generator of scanner stress inputs for bench.sh  */
+/****************************************************/
+
+/* usage: mkbench [-s megabytes] [-m mix] [-r seed] file
+ *
+ * Writes about the given number of megabytes of
+ * C-Minus text to file. The mix is a comma separated
+ * list of kind=weight pairs choosing how often each
+ * kind of item is emitted:
+ *   id      identifiers
+ *   kw      reserved words
+ *   num     numbers
+ *   op      one-character symbols
+ *   relop   two-character symbols (== != <= >=)
+ *   comment comments, some spanning lines
+ *   ws      extra runs of blanks and tabs
+ * Items are separated by single blanks and lines
+ * are broken at about LINEWIDTH columns, so no two
+ * items ever merge into one token. On success the
+ * counts are printed to stdout as
+ *   bytes=B tokens=T items=I
+ * where tokens excludes the final EOF
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* LINEWIDTH = column after which a line is broken */
+#define LINEWIDTH 72
+
+typedef enum { ID, KW, NUM, OP, RELOP, COMMENT, WS, NKINDS } Kind;
+
+static const char * kindName[NKINDS] =
+  { "id", "kw", "num", "op", "relop", "comment", "ws" };
+
+static const char * reserved[] =
+  { "if", "else", "while", "return", "int", "void" };
+static const char * ops[] =
+  { "+", "-", "*", "/", "<", ">", "=", ";", ",",
+    "(", ")", "[", "]", "{", "}" };
+static const char * relops[] = { "==", "!=", "<=", ">=" };
+
+#define COUNT(a) ((int) (sizeof(a) / sizeof((a)[0])))
+
+static int weight[NKINDS];
+static int totalWeight = 0;
+
+/* a small fixed generator, so a seed gives the same
+   file on every platform */
+static unsigned long rngState = 1;
+static unsigned rnd(unsigned n)
+{ rngState = rngState * 6364136223846793005UL + 1442695040888963407UL;
+  return (unsigned) (rngState >> 33) % n;
+}
+
+/* parseMix reads "kind=weight,..." into weight[] */
+static int parseMix(const char * mix)
+{ char name[16];
+  int w, n, k;
+  memset(weight,0,sizeof(weight));
+  totalWeight = 0;
+  while (*mix)
+  { if (sscanf(mix,"%15[a-z]=%d%n",name,&w,&n) != 2 || w < 0) return 0;
+    for (k = 0; k < NKINDS; k++)
+      if (strcmp(name,kindName[k]) == 0) break;
+    if (k == NKINDS) return 0;
+    weight[k] = w;
+    totalWeight += w;
+    mix += n;
+    if (*mix == ',') mix++;
+    else if (*mix) return 0;
+  }
+  return totalWeight > 0;
+}
+
+static Kind pickKind(void)
+{ int r = (int) rnd(totalWeight);
+  int k;
+  for (k = 0; r >= weight[k]; k++) r -= weight[k];
+  return (Kind) k;
+}
+
+/* item writes one item of kind k into buf and
+   returns its length */
+static int item(Kind k, char * buf)
+{ int i, n = 0, len;
+  switch (k)
+  { case ID:
+      len = 1 + rnd(10);
+      buf[n++] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"[rnd(52)];
+      for (i = 1; i < len; i++)
+        buf[n++] = "abcdefghijklmnopqrstuvwxyz0123456789"[rnd(36)];
+      buf[n] = '\0';
+      for (i = 0; i < COUNT(reserved); i++)
+        if (strcmp(buf,reserved[i]) == 0) buf[n++] = 'x';
+      break;
+    case KW:
+      n = sprintf(buf,"%s",reserved[rnd(COUNT(reserved))]);
+      break;
+    case NUM:
+      len = 1 + rnd(9);
+      for (i = 0; i < len; i++) buf[n++] = '0' + rnd(10);
+      break;
+    case OP:
+      n = sprintf(buf,"%s",ops[rnd(COUNT(ops))]);
+      break;
+    case RELOP:
+      n = sprintf(buf,"%s",relops[rnd(COUNT(relops))]);
+      break;
+    case COMMENT:
+      n = sprintf(buf,"/*");
+      len = 1 + rnd(8);
+      for (i = 0; i < len; i++)
+      { buf[n++] = rnd(4) ? ' ' : '\n';
+        n += sprintf(buf+n,"%s",rnd(2) ? "note" : "x * y / 2");
+      }
+      n += sprintf(buf+n," */");
+      break;
+    case WS:
+      len = 1 + rnd(16);
+      for (i = 0; i < len; i++) buf[n++] = rnd(4) ? ' ' : '\t';
+      break;
+    default:
+      break;
+  }
+  buf[n] = '\0';
+  return n;
+}
+
+int main(int argc, char * argv[])
+{ double megabytes = 16;
+  const char * mix = "id=35,kw=10,num=15,op=25,relop=5,comment=5,ws=5";
+  const char * out = NULL;
+  char buf[256];
+  long bytes = 0, target, tokens = 0, items = 0;
+  int column = 0, i;
+  FILE * f;
+
+  for (i = 1; i < argc; i++)
+  { if (strcmp(argv[i],"-s") == 0 && i+1 < argc) megabytes = atof(argv[++i]);
+    else if (strcmp(argv[i],"-m") == 0 && i+1 < argc) mix = argv[++i];
+    else if (strcmp(argv[i],"-r") == 0 && i+1 < argc) rngState = strtoul(argv[++i],NULL,10);
+    else if (out == NULL && argv[i][0] != '-') out = argv[i];
+    else out = NULL, i = argc;
+  }
+  if (out == NULL || megabytes <= 0)
+  { fprintf(stderr,"usage: %s [-s megabytes] [-m mix] [-r seed] file\n",argv[0]);
+    return 1;
+  }
+  if (!parseMix(mix))
+  { fprintf(stderr,"mkbench: bad mix \"%s\"\n",mix);
+    return 1;
+  }
+  f = fopen(out,"w");
+  if (f == NULL)
+  { fprintf(stderr,"mkbench: cannot write %s\n",out);
+    return 1;
+  }
+
+  target = (long) (megabytes * 1024 * 1024);
+  while (bytes < target)
+  { Kind k = pickKind();
+    int n = item(k,buf);
+    const char * nl = strrchr(buf,'\n');
+    fputs(buf,f);
+    fputc(' ',f);
+    bytes += n + 1;
+    column = nl ? (int) (buf + n - nl) : column + n + 1;
+    if (column > LINEWIDTH)
+    { fputc('\n',f);
+      bytes++;
+      column = 0;
+    }
+    if (k != COMMENT && k != WS) tokens++;
+    items++;
+  }
+  fputc('\n',f);
+  bytes++;
+  if (fclose(f) != 0)
+  { fprintf(stderr,"mkbench: cannot write %s\n",out);
+    return 1;
+  }
+  printf("bytes=%ld tokens=%ld items=%ld\n",bytes,tokens,items);
+  return 0;
+}
@@ -0,0 +1,568 @@
+/****************************************************/
+/* File: mkdfa.c                                    */
+/* Build-time generator of the direct-coded DFA     */
+/* scanner used by scandfa.c                        */
+/****************************************************/
+
+/* usage: mkdfa tokens.txt reserved.txt > dfa.h
+ *
+ * Builds the DFA of the tokens in tokens.txt (its
+ * rules are described at its top), with the words
+ * of reserved.txt matched inside the run they fit,
+ * and writes it out as one C function, dfaScan,
+ * with a label per state. A state reads a byte and
+ * jumps through go[state][class], a table of label
+ * offsets (the computed gotos of GCC and Clang),
+ * where class comes from the 256-byte dfaClass.
+ * Bytes that no state tells apart share a class,
+ * which keeps go small enough to stay in L1. NUL
+ * has a class of its own: the text is followed by
+ * a NUL sentinel, so only a NUL has to be checked
+ * against the end of the text
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FALSE 0
+#define TRUE 1
+
+/* MAXSTATES = the largest DFA handled */
+#define MAXSTATES 256
+/* MAXTOKENS = the most token names handled */
+#define MAXTOKENS 64
+/* MAXLITS = the most ops or reserved words handled */
+#define MAXLITS 128
+/* MAXRUNS = the most run rules handled */
+#define MAXRUNS 8
+/* MAXNAME = the longest token name or literal */
+#define MAXNAME 32
+
+/* what a byte read in a state leads to */
+typedef enum
+   { TO_STATE, /* on to state arg */
+     TO_ACCEPT, /* the byte ends token arg */
+     TO_UNGET /* the byte follows token arg: put it back */
+   } TargetKind;
+
+typedef struct
+   { TargetKind kind;
+     int arg;
+   } Target;
+
+typedef struct
+   { Target go[256];
+     int eofToken; /* token taken at the end of the text */
+     char what[2*MAXNAME+16]; /* what it has read, for dfa.h */
+   } State;
+
+static State states[MAXSTATES];
+static int nstates = 0;
+
+static char tokens[MAXTOKENS][MAXNAME+1];
+static int ntokens = 0;
+
+/* the rules of tokens.txt */
+typedef struct
+   { char text[MAXNAME+1];
+     int tok;
+   } Literal;
+
+typedef struct
+   { int tok;
+     unsigned char first[256];
+     unsigned char rest[256];
+   } Run;
+
+static unsigned char skipSet[256];
+static char commentOpen[MAXNAME+1] = "";
+static char commentClose[MAXNAME+1] = "";
+static Literal ops[MAXLITS];
+static int nops = 0;
+static Run runs[MAXRUNS];
+static int nruns = 0;
+static Literal words[MAXLITS];
+static int nwords = 0;
+
+static const char * specName;
+static int specLine;
+
+static void fail(const char * msg)
+{ fprintf(stderr,"mkdfa: %s:%d: %s\n",specName,specLine,msg);
+  exit(1);
+}
+
+/* tokenNo returns the number of token name,
+   adding it on first use */
+static int tokenNo(const char * name)
+{ int i;
+  for (i=0;i<ntokens;i++)
+    if (strcmp(tokens[i],name) == 0) return i;
+  if (ntokens == MAXTOKENS) fail("too many tokens");
+  strcpy(tokens[ntokens],name);
+  return ntokens++;
+}
+
+/*********************************************/
+/* reading the rules                         */
+/*********************************************/
+
+static const char * blanks(const char * p)
+{ while (*p == ' ' || *p == '\t') p++;
+  return p;
+}
+
+/* word reads the blank-delimited word at *p */
+static int word(const char ** p, char * buf)
+{ const char * s = blanks(*p);
+  int n = 0;
+  while (*s && *s != ' ' && *s != '\t' && *s != '\n' && *s != '\r')
+  { if (n == MAXNAME) fail("word too long");
+    buf[n++] = *s++;
+  }
+  buf[n] = '\0';
+  *p = s;
+  return n > 0;
+}
+
+/* byteClass reads the bracketed class at *p */
+static void byteClass(const char ** p, unsigned char * set)
+{ const char * s = blanks(*p);
+  int c, prev = -1, range = FALSE;
+  memset(set,0,256);
+  if (*s++ != '[') fail("byte class expected");
+  while (*s != ']')
+  { if (*s == '\0' || *s == '\n') fail("unterminated byte class");
+    if (*s == '-' && prev >= 0 && s[1] != ']')
+    { range = TRUE;
+      s++;
+      continue;
+    }
+    c = (unsigned char) *s++;
+    if (c == '\\')
+      switch (*s++)
+      { case 't': c = '\t'; break;
+        case 'n': c = '\n'; break;
+        case '\\': c = '\\'; break;
+        case ']': c = ']'; break;
+        case '-': c = '-'; break;
+        default: fail("unknown escape in byte class");
+      }
+    if (range)
+    { if (c < prev) fail("backward range in byte class");
+      while (prev <= c) set[prev++] = 1;
+      range = FALSE;
+      prev = -1;
+    }
+    else
+    { set[c] = 1;
+      prev = c;
+    }
+  }
+  *p = s + 1;
+}
+
+static void readSpec(const char * name)
+{ char line[256], kind[MAXNAME+1], a[MAXNAME+1], b[MAXNAME+1];
+  FILE * f = fopen(name,"r");
+  specName = name;
+  specLine = 0;
+  if (f == NULL) fail("cannot open");
+  while (fgets(line,sizeof line,f))
+  { const char * p = line;
+    specLine++;
+    if (line[0] == '#' || !word(&p,kind)) continue;
+    if (strcmp(kind,"skip") == 0)
+    { unsigned char set[256];
+      int c;
+      byteClass(&p,set);
+      for (c=0;c<256;c++) skipSet[c] |= set[c];
+    }
+    else if (strcmp(kind,"comment") == 0)
+    { if (commentOpen[0]) fail("only one comment rule is handled");
+      if (!word(&p,commentOpen) || !word(&p,commentClose))
+        fail("comment needs OPEN and CLOSE");
+    }
+    else if (strcmp(kind,"run") == 0)
+    { if (nruns == MAXRUNS) fail("too many runs");
+      if (!word(&p,a)) fail("run needs a TOKEN");
+      runs[nruns].tok = tokenNo(a);
+      byteClass(&p,runs[nruns].first);
+      byteClass(&p,runs[nruns].rest);
+      nruns++;
+    }
+    else if (strcmp(kind,"op") == 0)
+    { if (nops == MAXLITS) fail("too many ops");
+      if (!word(&p,a) || !word(&p,b)) fail("op needs TEXT and TOKEN");
+      strcpy(ops[nops].text,a);
+      ops[nops].tok = tokenNo(b);
+      nops++;
+    }
+    else fail("unknown rule");
+    if (word(&p,a)) fail("junk at end of rule");
+  }
+  fclose(f);
+}
+
+/* readWords reads the "lexeme TOKEN" lines of the
+   reserved word list */
+static void readWords(const char * name)
+{ char line[256], str[256], tok[256];
+  FILE * f = fopen(name,"r");
+  specName = name;
+  specLine = 0;
+  if (f == NULL) fail("cannot open");
+  while (fgets(line,sizeof line,f))
+  { specLine++;
+    if (line[0] == '#' || sscanf(line,"%255s %255s",str,tok) != 2)
+      continue;
+    if (nwords == MAXLITS || strlen(str) > MAXNAME || strlen(tok) > MAXNAME)
+      fail("too many or too long words");
+    strcpy(words[nwords].text,str);
+    words[nwords].tok = tokenNo(tok);
+    nwords++;
+  }
+  fclose(f);
+}
+
+/*********************************************/
+/* building the DFA                          */
+/*********************************************/
+
+static Target to(TargetKind kind, int arg)
+{ Target t;
+  t.kind = kind;
+  t.arg = arg;
+  return t;
+}
+
+/* newState makes a state that ends token tok at
+   any byte (or at the end of the text) that it
+   has no other use for */
+static int newState(int tok, TargetKind kind, const char * what)
+{ int c;
+  if (nstates == MAXSTATES) fail("too many states");
+  for (c=0;c<256;c++) states[nstates].go[c] = to(kind,tok);
+  states[nstates].eofToken = tok;
+  strcpy(states[nstates].what,what);
+  return nstates++;
+}
+
+/* startRule[c] tells which rule claimed byte c in
+   the start state, so rules that would take it two
+   ways are caught */
+static const char * startRule[256];
+
+static void setStart(int c, Target t, const char * rule)
+{ if (startRule[c] && (states[0].go[c].kind != t.kind || states[0].go[c].arg != t.arg))
+  { fprintf(stderr,"mkdfa: byte %d starts both %s and %s\n",c,startRule[c],rule);
+    exit(1);
+  }
+  startRule[c] = rule;
+  states[0].go[c] = t;
+}
+
+/* the trie being built: a state for each prefix of
+   an op or of the comment opener that some longer
+   one goes on from, and later for each prefix of a
+   reserved word */
+static char trieText[MAXSTATES][MAXNAME+1];
+static int trieState[MAXSTATES];
+static int ntrie = 0;
+
+static int lit(int i, const char ** text)
+{ if (i < nops) *text = ops[i].text;
+  else if (i == nops && commentOpen[0]) *text = commentOpen;
+  else return FALSE;
+  return TRUE;
+}
+
+/* goesOn tells whether a literal extends p[0..len) */
+static int goesOn(const char * p, int len)
+{ const char * text;
+  int i;
+  for (i=0;lit(i,&text);i++)
+    if ((int) strlen(text) > len && memcmp(text,p,len) == 0) return TRUE;
+  return FALSE;
+}
+
+/* opToken returns the token of op p[0..len), or
+   -1 if there is none */
+static int opToken(const char * p, int len)
+{ int i;
+  for (i=0;i<nops;i++)
+    if ((int) strlen(ops[i].text) == len && memcmp(ops[i].text,p,len) == 0)
+      return ops[i].tok;
+  return -1;
+}
+
+static int trieLookup(const char * p, int len)
+{ int i;
+  for (i=0;i<ntrie;i++)
+    if ((int) strlen(trieText[i]) == len && memcmp(trieText[i],p,len) == 0)
+      return trieState[i];
+  return -1;
+}
+
+static void buildOps(int commentState)
+{ const char * text;
+  int i, len;
+  /* states for the prefixes the trie goes on from */
+  for (i=0;lit(i,&text);i++)
+    for (len=1;len<=(int) strlen(text);len++)
+    { int tok = opToken(text,len);
+      char what[2*MAXNAME+16];
+      if (!goesOn(text,len) || trieLookup(text,len) >= 0) continue;
+      if (commentOpen[0] && (int) strlen(commentOpen) == len &&
+          memcmp(commentOpen,text,len) == 0)
+        fail("the comment opener starts another token");
+      if (tok < 0)
+      { /* only a lone first byte may fall back on ERROR;
+           anything longer would need backtracking */
+        if (len > 1) fail("an op prefix is no token of its own");
+        tok = tokenNo("ERROR");
+      }
+      if (ntrie == MAXSTATES) fail("too many ops");
+      memcpy(trieText[ntrie],text,len);
+      trieText[ntrie][len] = '\0';
+      sprintf(what,"read \"%s\"",trieText[ntrie]);
+      trieState[ntrie++] = newState(tok,TO_UNGET,what);
+    }
+  /* their transitions: on into the trie, into the
+     comment, or to the op a byte completes */
+  for (i=0;lit(i,&text);i++)
+    for (len=1;len<=(int) strlen(text);len++)
+    { int from = len == 1 ? 0 : trieLookup(text,len-1);
+      int next = trieLookup(text,len);
+      Target t;
+      if (next >= 0) t = to(TO_STATE,next);
+      else if (text == commentOpen) t = to(TO_STATE,commentState);
+      else t = to(TO_ACCEPT,opToken(text,len));
+      if (from == 0) setStart((unsigned char) text[0],t,text == commentOpen ? "comment" : "op");
+      else states[from].go[(unsigned char) text[len-1]] = t;
+    }
+}
+
+/* buildComment makes the states that skip a comment
+   up to its closer: state j has matched j bytes of
+   the closer, as in Knuth-Morris-Pratt matching */
+static int buildComment(void)
+{ int k = strlen(commentClose), first = nstates, j, c;
+  char what[2*MAXNAME+16];
+  for (j=0;j<k;j++)
+  { if (j == 0) strcpy(what,"in comment");
+    else sprintf(what,"in comment, read \"%.*s\" of its closer",j,commentClose);
+    newState(tokenNo("ENDFILE"),TO_STATE,what);
+  }
+  for (j=0;j<k;j++)
+    for (c=0;c<256;c++)
+    { char seen[MAXNAME+2];
+      int m;
+      memcpy(seen,commentClose,j);
+      seen[j] = (char) c;
+      /* longest suffix of seen that starts the closer */
+      for (m=j+1;m>0;m--)
+        if (memcmp(seen+j+1-m,commentClose,m) == 0) break;
+      states[first+j].go[c] = m == k ? to(TO_STATE,0) : to(TO_STATE,first+m);
+    }
+  return first;
+}
+
+/* buildRuns makes a state for each run and one for
+   each prefix of a reserved word, which ends with
+   the word's token or the run's */
+static void buildRuns(void)
+{ int r, i, len, c, n;
+  int runOf[MAXLITS];
+  for (i=0;i<nwords;i++)
+  { const unsigned char * w = (const unsigned char *) words[i].text;
+    for (r=0;r<nruns;r++)
+    { for (n=1;w[n] && runs[r].rest[w[n]];n++)
+        ;
+      if (runs[r].first[w[0]] && w[n] == '\0') break;
+    }
+    if (r == nruns)
+    { fprintf(stderr,"mkdfa: reserved word %s fits no run\n",words[i].text);
+      exit(1);
+    }
+    runOf[i] = r;
+  }
+  for (r=0;r<nruns;r++)
+  { char what[2*MAXNAME+16];
+    int g;
+    ntrie = 0; /* the trie is for the words of this run */
+    sprintf(what,"in %s",tokens[runs[r].tok]);
+    g = newState(runs[r].tok,TO_UNGET,what);
+    for (c=0;c<256;c++)
+    { if (runs[r].rest[c]) states[g].go[c] = to(TO_STATE,g);
+      if (runs[r].first[c]) setStart(c,to(TO_STATE,g),tokens[runs[r].tok]);
+    }
+    /* the prefixes of its words, shortest first */
+    for (len=1;len<=MAXNAME;len++)
+      for (i=0;i<nwords;i++)
+      { const char * w = words[i].text;
+        int tok = runs[r].tok, s, j;
+        if (runOf[i] != r || (int) strlen(w) < len) continue;
+        for (j=0;j<i;j++) /* made for an earlier word? */
+          if (runOf[j] == r && (int) strlen(words[j].text) >= len &&
+              memcmp(words[j].text,w,len) == 0) break;
+        if (j < i) continue;
+        for (j=0;j<nwords;j++)
+          if ((int) strlen(words[j].text) == len && memcmp(words[j].text,w,len) == 0)
+            tok = words[j].tok;
+        sprintf(what,"in %s, read \"%.*s\"",tokens[runs[r].tok],len,w);
+        s = newState(tok,TO_UNGET,what);
+        for (c=0;c<256;c++)
+          if (runs[r].rest[c]) states[s].go[c] = to(TO_STATE,g);
+        if (ntrie == MAXSTATES) fail("too many reserved words");
+        memcpy(trieText[ntrie],w,len);
+        trieText[ntrie][len] = '\0';
+        trieState[ntrie++] = s;
+        if (len == 1) states[0].go[(unsigned char) w[0]] = to(TO_STATE,s);
+        else states[trieLookup(w,len-1)].go[(unsigned char) w[len-1]] = to(TO_STATE,s);
+      }
+  }
+}
+
+/*********************************************/
+/* byte classes and output                   */
+/*********************************************/
+
+static int classOf[256];
+static int nclasses = 0;
+static unsigned char classByte[256]; /* a byte of each class */
+
+static int sameColumn(int a, int b)
+{ int s;
+  for (s=0;s<nstates;s++)
+    if (states[s].go[a].kind != states[s].go[b].kind ||
+        states[s].go[a].arg != states[s].go[b].arg) return FALSE;
+  return TRUE;
+}
+
+/* buildClasses groups bytes that every state treats
+   alike; NUL stays alone */
+static void buildClasses(void)
+{ int c, k;
+  classOf[0] = nclasses++;
+  classByte[0] = 0;
+  for (c=1;c<256;c++)
+  { for (k=1;k<nclasses;k++)
+      if (sameColumn(c,classByte[k])) break;
+    if (k == nclasses)
+    { classByte[k] = c;
+      nclasses++;
+    }
+    classOf[c] = k;
+  }
+}
+
+static void label(char * buf, Target t)
+{ switch (t.kind)
+  { case TO_STATE: sprintf(buf,"S%d",t.arg); break;
+    case TO_ACCEPT: sprintf(buf,"A_%s",tokens[t.arg]); break;
+    case TO_UNGET: sprintf(buf,"U_%s",tokens[t.arg]); break;
+  }
+}
+
+static void emit(const char * specFile, const char * wordFile)
+{ int usedA[MAXTOKENS] = {0}, usedU[MAXTOKENS] = {0};
+  char buf[2*MAXNAME+16];
+  int s, k, c;
+  for (s=0;s<nstates;s++)
+    for (c=0;c<256;c++)
+    { Target t = states[s].go[c];
+      if (t.kind == TO_ACCEPT) usedA[t.arg] = TRUE;
+      if (t.kind == TO_UNGET) usedU[t.arg] = TRUE;
+    }
+
+  printf("/* Generated by mkdfa from %s and %s - do not edit */\n\n",specFile,wordFile);
+  printf("#ifndef __GNUC__\n");
+  printf("#error \"dfa.h needs the computed gotos of GCC or Clang\"\n");
+  printf("#endif\n\n");
+  printf("/* DFASTATES = states of the DFA, DFACLASSES = byte\n");
+  printf("   classes; the tables take %d bytes */\n",
+         256 + nstates * nclasses * (int) sizeof(int));
+  printf("#define DFASTATES %d\n",nstates);
+  printf("#define DFACLASSES %d\n\n",nclasses);
+  printf("/* class of every byte; class 0 is NUL alone, which\n");
+  printf("   is also the sentinel past the end of the text */\n");
+  printf("static const unsigned char dfaClass[256] =\n   {");
+  for (c=0;c<256;c++)
+    printf("%s%d%s",c%16 ? " " : "\n    ",classOf[c],c < 255 ? "," : "");
+  printf("\n   };\n\n");
+
+  printf("/* dfaScan lexes the token at *pp, leaving *pp just\n");
+  printf("   past it and *start at its first byte; every read\n");
+  printf("   of the sentinel at end counts in *eofs, and the\n");
+  printf("   scan stays there, so from then on it returns\n");
+  printf("   ENDFILE */\n");
+  printf("static TokenType dfaScan(const unsigned char ** pp, const unsigned char * end,\n");
+  printf("                         const unsigned char ** start, int * eofs)\n");
+  printf("{ /* label of each state and class, as an offset from S0 */\n");
+  printf("  static const int go[DFASTATES][DFACLASSES] =\n     {");
+  for (s=0;s<nstates;s++)
+  { printf("%s /* S%d: %s */\n       {",s ? "," : "",s,states[s].what);
+    for (k=0;k<nclasses;k++)
+    { if (k == 0) sprintf(buf,"Z%d",s);
+      else label(buf,states[s].go[classByte[k]]);
+      printf("%s&&%s - &&S0",k == 0 ? " " : k % 4 ? ", " : ",\n         ",buf);
+    }
+    printf(" }\n    ");
+  }
+  printf(" };\n");
+  printf("  const unsigned char * p = *pp;\n");
+  printf("  const unsigned char * s;\n");
+  printf("  TokenType tok;\n\n");
+
+  printf("  /* each state reads a byte and jumps by its class */\n");
+  printf("S0: s = p;\n");
+  printf("  goto *(&&S0 + go[0][dfaClass[*p++]]);\n");
+  for (s=1;s<nstates;s++)
+    printf("S%d: goto *(&&S0 + go[%d][dfaClass[*p++]]); /* %s */\n",s,s,states[s].what);
+
+  printf("\n  /* a NUL past the text is the end of it */\n");
+  for (s=0;s<nstates;s++)
+  { label(buf,states[s].go[0]);
+    printf("Z%d: if (p > end) { p = end; (*eofs)++; tok = %s; goto done; }\n",
+           s,tokens[states[s].eofToken]);
+    printf("  goto %s;\n",buf);
+  }
+
+  printf("\n  /* the token ends with the byte just read */\n");
+  for (k=0;k<ntokens;k++)
+    if (usedA[k]) printf("A_%s: tok = %s; goto done;\n",tokens[k],tokens[k]);
+  printf("\n  /* the token ends before the byte just read */\n");
+  for (k=0;k<ntokens;k++)
+    if (usedU[k]) printf("U_%s: p--; tok = %s; goto done;\n",tokens[k],tokens[k]);
+
+  printf("\ndone:\n");
+  printf("  *pp = p;\n");
+  printf("  *start = s;\n");
+  printf("  return tok;\n");
+  printf("}\n");
+}
+
+int main(int argc, char * argv[])
+{ int c, comment = -1;
+  if (argc != 3)
+  { fprintf(stderr,"usage: %s <token rules> <reserved word list>\n",argv[0]);
+    exit(1);
+  }
+  tokenNo("ENDFILE");
+  tokenNo("ERROR");
+  readSpec(argv[1]);
+  readWords(argv[2]);
+
+  newState(tokenNo("ENDFILE"),TO_ACCEPT,"start");
+  for (c=0;c<256;c++) states[0].go[c] = to(TO_ACCEPT,tokenNo("ERROR"));
+  for (c=0;c<256;c++)
+    if (skipSet[c]) setStart(c,to(TO_STATE,0),"skip");
+  if (commentOpen[0]) comment = buildComment();
+  buildOps(comment);
+  buildRuns();
+  buildClasses();
+  emit(argv[1],argv[2]);
+  return 0;
+}
@@ -0,0 +1,191 @@
+/****************************************************/
+/* File: mkreserved.c                               */
+/* Build-time generator of the perfect hash table   */
+/* used by reservedLookup in scan.c                 */
+/****************************************************/
+
+/* usage: mkreserved reserved.txt > reserved.h
+ *
+ * The hash of a lexeme is
+ *   (len + asso[first] + asso[last]) % SIZE
+ * where first and last are its first and last
+ * characters and asso is a small table of per-
+ * character values. mkreserved searches for asso
+ * values that give every reserved word its own
+ * slot, starting with SIZE equal to the number of
+ * words (a minimal perfect hash) and widening the
+ * table if no assignment turns up within MAXSTEPS
+ * tries at that size
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* MAXWORDS = the largest reserved word list handled */
+#define MAXWORDS 64
+/* MAXWORDLEN = the longest reserved word handled */
+#define MAXWORDLEN 32
+/* MAXSTEPS = search budget per table size */
+#define MAXSTEPS 20000000L
+
+static struct
+    { char str[MAXWORDLEN+1];
+      char tok[MAXWORDLEN+1];
+    } words[MAXWORDS];
+static int nwords = 0;
+
+/* search state: asso values, and for each character
+   whether it has been assigned one yet */
+static unsigned asso[256];
+static int assigned[256];
+static unsigned char chars[2*MAXWORDS]; /* distinct first/last chars */
+static int nchars = 0;
+static int slotOf[2*MAXWORDS]; /* word index per slot, -1 if free */
+static unsigned size;
+static long steps;
+
+static unsigned char firstChar(int i)
+{ return (unsigned char) words[i].str[0]; }
+
+static unsigned char lastChar(int i)
+{ return (unsigned char) words[i].str[strlen(words[i].str)-1]; }
+
+static unsigned hash(int i)
+{ return (strlen(words[i].str) + asso[firstChar(i)] + asso[lastChar(i)]) % size; }
+
+/* search assigns asso values to chars[k..] by
+   backtracking; a word takes its slot as soon as
+   both of its characters have values */
+static int search(int k)
+{ unsigned v;
+  int i, ok;
+  if (k == nchars) return 1;
+  for (v=0;v<size && steps<MAXSTEPS;v++)
+  { steps++;
+    asso[chars[k]] = v;
+    assigned[chars[k]] = 1;
+    ok = 1;
+    for (i=0;i<nwords;i++)
+      if ((firstChar(i) == chars[k] || lastChar(i) == chars[k]) &&
+          assigned[firstChar(i)] && assigned[lastChar(i)])
+      { unsigned h = hash(i);
+        if (slotOf[h] >= 0 && slotOf[h] != i) ok = 0;
+        else slotOf[h] = i;
+        if (!ok) break;
+      }
+    if (ok && search(k+1)) return 1;
+    /* undo the slots taken at this level */
+    for (i=0;i<(int)size;i++)
+      if (slotOf[i] >= 0 &&
+          (firstChar(slotOf[i]) == chars[k] || lastChar(slotOf[i]) == chars[k]))
+        slotOf[i] = -1;
+  }
+  assigned[chars[k]] = 0;
+  asso[chars[k]] = 0;
+  return 0;
+}
+
+/* uses counts how many words start or end with c */
+static int uses(unsigned char c)
+{ int i, n = 0;
+  for (i=0;i<nwords;i++)
+    n += (firstChar(i) == c) + (lastChar(i) == c);
+  return n;
+}
+
+/* addChar records c as a search variable, keeping
+   chars ordered by decreasing use so that most
+   words are placed (and collisions pruned) early */
+static void addChar(unsigned char c)
+{ int i, j;
+  for (i=0;i<nchars;i++)
+    if (chars[i] == c) return;
+  for (i=0;i<nchars && uses(chars[i]) >= uses(c);i++)
+    ;
+  for (j=nchars;j>i;j--) chars[j] = chars[j-1];
+  chars[i] = c;
+  nchars++;
+}
+
+static void readWords(const char * name)
+{ char line[256];
+  FILE * f = fopen(name,"r");
+  if (f == NULL)
+  { fprintf(stderr,"mkreserved: cannot open %s\n",name);
+    exit(1);
+  }
+  while (fgets(line,sizeof line,f))
+  { char str[256], tok[256];
+    if (line[0] == '#' || sscanf(line,"%255s %255s",str,tok) != 2)
+      continue;
+    if (nwords == MAXWORDS || strlen(str) > MAXWORDLEN || strlen(tok) > MAXWORDLEN)
+    { fprintf(stderr,"mkreserved: %s: too many or too long words\n",name);
+      exit(1);
+    }
+    strcpy(words[nwords].str,str);
+    strcpy(words[nwords].tok,tok);
+    nwords++;
+  }
+  fclose(f);
+}
+
+static void emit(const char * name)
+{ unsigned h;
+  int c;
+  printf("/* Generated by mkreserved from %s - do not edit */\n\n",name);
+  printf("#if MAXRESERVED != %d\n",nwords);
+  printf("#error \"MAXRESERVED in globals.h does not match %s\"\n",name);
+  printf("#endif\n\n");
+  printf("/* RESERVEDSIZE = number of slots in reservedWords */\n");
+  printf("#define RESERVEDSIZE %u\n\n",size);
+  printf("/* per-character values of the reserved word hash */\n");
+  printf("static const unsigned char reservedAsso[256] =\n   {");
+  for (c=0;c<256;c++)
+    printf("%s%u%s",c%16 ? " " : "\n    ",asso[c],c < 255 ? "," : "");
+  printf("\n   };\n\n");
+  printf("/* RESERVEDHASH maps a lexeme's length, first and last\n");
+  printf("   characters to its only possible slot */\n");
+  printf("#define RESERVEDHASH(len,first,last) \\\n");
+  printf("   (((unsigned)(len) + reservedAsso[(unsigned char)(first)] + \\\n");
+  printf("     reservedAsso[(unsigned char)(last)]) %% RESERVEDSIZE)\n\n");
+  printf("/* lookup table of reserved words */\n");
+  printf("static const struct\n");
+  printf("    { const char * str;\n");
+  printf("      int len;\n");
+  printf("      TokenType tok;\n");
+  printf("    } reservedWords[RESERVEDSIZE]\n");
+  printf("   = {\n");
+  for (h=0;h<size;h++)
+    if (slotOf[h] < 0) printf("    {\"\", 0, ID},\n");
+    else printf("    {\"%s\", %d, %s},\n",words[slotOf[h]].str,
+                (int) strlen(words[slotOf[h]].str),words[slotOf[h]].tok);
+  printf("   };\n");
+}
+
+int main(int argc, char * argv[])
+{ int i;
+  if (argc != 2)
+  { fprintf(stderr,"usage: %s <reserved word list>\n",argv[0]);
+    exit(1);
+  }
+  readWords(argv[1]);
+  if (nwords == 0)
+  { fprintf(stderr,"mkreserved: %s lists no words\n",argv[1]);
+    exit(1);
+  }
+  for (i=0;i<nwords;i++)
+  { addChar(firstChar(i));
+    addChar(lastChar(i));
+  }
+  for (size=nwords;size<=2*(unsigned)nwords;size++)
+  { for (i=0;i<2*MAXWORDS;i++) slotOf[i] = -1;
+    steps = 0;
+    if (search(0))
+    { emit(argv[1]);
+      return 0;
+    }
+  }
+  fprintf(stderr,"mkreserved: no perfect hash found for %s\n",argv[1]);
+  return 1;
+}
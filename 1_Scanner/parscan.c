@@ -0,0 +1,128 @@
+/****************************************************/
+/* File: parscan.c                                  */
+/* Parallel speculative lexing for the scanner      */
+/****************************************************/
+
+#include "globals.h"
+#include "parscan.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+/* SCAN_THREADS = number of lexing threads, 0 to use
+   one per online CPU */
+#ifndef SCAN_THREADS
+#define SCAN_THREADS 0
+#endif
+
+/* MINCHUNK = smallest chunk worth a thread; files
+   under two chunks are lexed serially */
+#ifndef MINCHUNK
+#define MINCHUNK (1 << 20)
+#endif
+
+/* CHUNKSPERTHREAD = chunks per thread, so a thread
+   that finishes early can take another chunk */
+#define CHUNKSPERTHREAD 4
+
+/* GUESSWINDOW = how far back guessComment looks for
+   a comment delimiter */
+#define GUESSWINDOW 4096
+
+/* guessComment guesses whether offset pos of text
+   lies inside a comment, by which of slash-star or
+   star-slash comes last in the bytes before it */
+static int guessComment(const char * text, size_t pos)
+{ size_t stop = pos > GUESSWINDOW ? pos - GUESSWINDOW : 0;
+  size_t i;
+  for (i = pos; i >= stop + 2; i--)
+  { if (text[i-2] == '*' && text[i-1] == '/') return FALSE;
+    if (text[i-2] == '/' && text[i-1] == '*') return TRUE;
+  }
+  return FALSE;
+}
+
+/* work shared by the lexing threads */
+typedef struct
+   { ScanChunk * chunks;
+     int count;
+     int next; /* next chunk to hand out */
+     int failed;
+   } LexWork;
+
+static void * lexWorker(void * arg)
+{ LexWork * w = arg;
+  int i;
+  while ((i = __sync_fetch_and_add(&w->next,1)) < w->count)
+    if (!lexChunk(w->chunks + i, i == w->count - 1))
+      w->failed = TRUE;
+  return NULL;
+}
+
+static void freeChunks(ScanChunk * chunks, int count)
+{ int i;
+  for (i = 0; i < count; i++) free(chunks[i].tokens);
+  free(chunks);
+}
+
+ScanChunk * parallelLex(const char * text, size_t len, int * count)
+{ long nthreads = SCAN_THREADS ? SCAN_THREADS : sysconf(_SC_NPROCESSORS_ONLN);
+  pthread_t threads[64];
+  ScanChunk * chunks;
+  LexWork work;
+  size_t chunkLen, pos;
+  int n, i, started, inComment;
+
+  if (nthreads > 64) nthreads = 64;
+  if (nthreads < 2 || len < 2 * (size_t) MINCHUNK) return NULL;
+  n = nthreads * CHUNKSPERTHREAD;
+  chunkLen = len / n;
+  if (chunkLen < MINCHUNK) chunkLen = MINCHUNK;
+
+  /* split at line boundaries, so every chunk but the
+     last ends with a newline */
+  chunks = calloc(n,sizeof(ScanChunk));
+  if (chunks == NULL) return NULL;
+  for (i = 0, pos = 0; i < n && pos < len; i++)
+  { const char * nl = NULL;
+    size_t end = len;
+    if (len - pos > chunkLen && i < n - 1)
+      nl = memchr(text + pos + chunkLen,'\n',len - pos - chunkLen);
+    if (nl != NULL) end = nl - text + 1;
+    chunks[i].text = text + pos;
+    chunks[i].len = end - pos;
+    chunks[i].guess = pos > 0 && guessComment(text,pos);
+    pos = end;
+  }
+  n = i;
+
+  /* lex every chunk on its guessed entry state */
+  work.chunks = chunks;
+  work.count = n;
+  work.next = 0;
+  work.failed = FALSE;
+  if (nthreads > n) nthreads = n;
+  for (started = 0; started < nthreads; started++)
+    if (pthread_create(&threads[started],NULL,lexWorker,&work) != 0) break;
+  if (started == 0) lexWorker(&work);
+  for (i = 0; i < started; i++) pthread_join(threads[i],NULL);
+
+  /* stitch: the true entry state of a chunk is the
+     exit state of the one before it; a chunk lexed
+     on a wrong guess is lexed again, which may in
+     turn change what the next chunk should see */
+  inComment = FALSE;
+  for (i = 0; i < n && !work.failed; i++)
+  { if (chunks[i].guess != inComment)
+    { chunks[i].guess = inComment;
+      if (!lexChunk(chunks + i, i == n - 1)) work.failed = TRUE;
+    }
+    inComment = chunks[i].inComment;
+  }
+  if (work.failed)
+  { freeChunks(chunks,n);
+    return NULL;
+  }
+  *count = n;
+  return chunks;
+}
@@ -0,0 +1,50 @@
+/****************************************************/
+/* File: parscan.h                                  */
+/* Parallel speculative lexing for the scanner      */
+/****************************************************/
+
+#ifndef _PARSCAN_H_
+#define _PARSCAN_H_
+
+/* ChunkToken is one token lexed from a chunk; its
+ * lexeme is the len bytes at offset in the chunk
+ * text, and its line is found from endpos (or eofs)
+ * through the newline index when it is replayed
+ */
+typedef struct
+   { unsigned offset;
+     unsigned endpos; /* last character fetched for it */
+     unsigned char token;
+     unsigned char len;
+     unsigned char eofs; /* EOFs fetched by then */
+   } ChunkToken;
+
+/* ScanChunk is a slice of the source that starts
+ * at a line boundary, together with its tokens
+ */
+typedef struct
+   { const char * text;
+     size_t len;
+     int guess; /* TRUE if lexed as starting in a comment */
+     int inComment; /* TRUE if it ended inside a comment */
+     ChunkToken * tokens;
+     int ntokens;
+     int capacity;
+   } ScanChunk;
+
+/* Function lexChunk (in scan.c) lexes chunk c with
+ * the scanner DFA; only the last chunk keeps its
+ * ENDFILE token. Returns FALSE if out of memory
+ */
+int lexChunk( ScanChunk * c, int last );
+
+/* Function parallelLex splits the len bytes at text
+ * into chunks, lexes them on several threads and
+ * re-lexes the chunks whose comment guess was wrong.
+ * Returns the chunks (their count in *count), or
+ * NULL if the text is too small to be worth it or
+ * anything fails, so the caller lexes serially
+ */
+ScanChunk * parallelLex( const char * text, size_t len, int * count );
+
+#endif
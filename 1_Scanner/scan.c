@@ -8,6 +8,12 @@
 #include "globals.h"
 #include "util.h"
 #include "scan.h"
+#include "source.h"
+#include "simd.h"
+#include "parscan.h"
+#include "lines.h"
+#include "tracebin.h"
+#include "scanstats.h"
 
 /* states in scanner DFA */
 typedef enum
@@ -15,81 +21,181 @@ typedef enum
    StateType;
 
 /* lexeme of identifier or reserved word */
-char tokenString[MAXTOKENLEN+1];
+char tokenString[MAXTOKENLEN+2];
 
 /* BUFLEN = length of the input buffer for
    source code lines */
 #define BUFLEN 256
 
-static char lineBuf[BUFLEN]; /* holds the current line */
-static int linepos = 0; /* current position in LineBuf */
-static int bufsize = 0; /* current size of buffer string */
-static int EOF_flag = FALSE; /* corrects ungetNextChar behavior on EOF */
+/* ScanState is everything the DFA reads and writes
+   while it lexes one range of text, so the serial
+   scanner and each parallel chunk own their own */
+typedef struct
+   { const char * lineBuf; /* holds the current line */
+     int linepos; /* current position in lineBuf */
+     int bufsize; /* current size of buffer string */
+     int EOF_flag; /* corrects ungetNextChar behavior on EOF */
+     const char * text; /* range being lexed, NULL for fgets input */
+     size_t len;
+     SourceRing * ring; /* streamed input, NULL if none */
+     int partial; /* TRUE if lineBuf ends mid-line */
+     size_t nextpos; /* offset of the line after lineBuf */
+     int lazy; /* TRUE if the range is fetched as one line */
+     int lineno; /* lines fetched, counting each EOF */
+     int ungot; /* TRUE if the token ended on ungetNextChar */
+     char * tokenString;
+     const char * tokenText; /* where the saved lexeme starts */
+     int tokenLen;
+     StateType entry; /* state the next token starts in */
+     int inComment; /* TRUE if EOF was met inside a comment */
+#if SCAN_STATS
+     ScanStats * stats; /* counters of the scan or chunk */
+     StateType statFrom; /* state of the DFA step being counted */
+     int statPos; /* where a bulk skip started */
+#endif
+   } ScanState;
+
+static char lineStore[BUFLEN]; /* line buffer for fgets input */
+static ScanState serial = { lineStore, 0, 0, FALSE, NULL, 0, NULL, FALSE, 0,
+                            FALSE, 0, FALSE, tokenString, NULL, 0, START, FALSE
+#if SCAN_STATS
+                            , &scanStats, START, 0
+#endif
+                          };
+
+/* whole-file input for the serial scanner, or the
+   ring it streams through when the source is not
+   a regular file */
+static SourceBuf srcBuf;
+static SourceRing srcRing;
+static int srcLoaded = FALSE;
+
+/* newlines of srcBuf, for scans in lazy mode */
+static LineIndex lines;
+
+/* where the lexeme of the last token lies in srcBuf,
+   for the binary trace; -1 if srcBuf is not used */
+static long tokenOffset = -1;
+static int tokenLength = 0;
+
+/* parallel mode: the chunks lexed by parallelLex and
+   the replay position in them */
+static ScanChunk * chunks = NULL;
+static int nchunks = 0;
+static int curChunk = 0;
+static int curToken = 0;
+
+/* nextLine makes lineBuf the next line of the range,
+   returning FALSE at its end. For buffered input
+   the line is a slice of the text, so lines are
+   neither copied nor split at BUFLEN; in lazy mode
+   the whole range is one slice, newlines are plain
+   blanks to the DFA and tokenLine recovers the line
+   numbers from the newline index. Streamed input
+   comes a piece of the ring at a time; a line that
+   straddles a refill is several partial pieces, and
+   as the DFA keeps its state from one to the next,
+   tokens and comments may straddle them too */
+static int nextLine(ScanState * s)
+{ const char * nl;
+  if (s->ring != NULL)
+  { if (!ringLine(s->ring,&s->lineBuf,&s->bufsize)) return FALSE;
+    s->partial = s->lineBuf[s->bufsize-1] != '\n';
+    return TRUE;
+  }
+  if (s->text == NULL)
+  { if (!fgets(lineStore,BUFLEN-1,source)) return FALSE;
+    s->bufsize = strlen(lineStore);
+    return TRUE;
+  }
+  if (s->nextpos >= s->len) return FALSE;
+  s->lineBuf = s->text + s->nextpos;
+  nl = s->lazy ? NULL : memchr(s->lineBuf,'\n',s->len - s->nextpos);
+  s->bufsize = nl ? (size_t) (nl - s->lineBuf) + 1 : s->len - s->nextpos;
+  s->nextpos += s->bufsize;
+  return TRUE;
+}
 
 /* getNextChar fetches the next non-blank character
    from lineBuf, reading in a new line if lineBuf is
-   exhausted */
-static int getNextChar(void)
-{ if (!(linepos < bufsize))
-  { lineno++;
-    if (fgets(lineBuf,BUFLEN-1,source))
-    { if (EchoSource) fprintf(listing,"%4d: %s",lineno,lineBuf);
-      bufsize = strlen(lineBuf);
-      linepos = 0;
-      return lineBuf[linepos++];
+   exhausted; the rest of a partial line does not
+   count as a line of its own */
+static int getNextChar(ScanState * s)
+{ if (!(s->linepos < s->bufsize))
+  { int rest = s->partial;
+    if (nextLine(s))
+    { SCANSTAT(s->stats->bytes += s->bufsize);
+      if (!rest)
+      { s->lineno++;
+        if (EchoSource) fprintf(listing,"%4d: ",s->lineno);
+      }
+      if (EchoSource) fprintf(listing,"%.*s",s->bufsize,s->lineBuf);
+      s->linepos = 0;
+      return s->lineBuf[s->linepos++];
     }
     else
-    { EOF_flag = TRUE;
+    { s->lineno++;
+      s->EOF_flag = TRUE;
       return EOF;
     }
   }
-  else return lineBuf[linepos++];
+  else return s->lineBuf[s->linepos++];
 }
 
 /* ungetNextChar backtracks one character
    in lineBuf */
-static void ungetNextChar(void)
-{ if (!EOF_flag) linepos-- ;}
+static void ungetNextChar(ScanState * s)
+{ if (!s->EOF_flag)
+  { s->linepos-- ;
+    s->ungot = TRUE;
+    SCANSTAT(s->stats->ungets++);
+  }
+}
 
-/* lookup table of reserved words */
-static struct
-    { char* str;
-      TokenType tok;
-    } reservedWords[MAXRESERVED]
-   = {
-    {"if", IF}, {"else", ELSE},
-    {"while", WHILE}, {"return", RETURN},
-    {"int", INT}, {"void", VOID},
-   };
+/* reservedWords and RESERVEDHASH are generated from
+   reserved.txt by mkreserved */
+#include "reserved.h"
 
 /* lookup an identifier to see if it is a reserved word */
-/* uses linear search */
-static TokenType reservedLookup (char * s)
-{ int i;
-  for (i=0;i<MAXRESERVED;i++)
-    if (!strcmp(s,reservedWords[i].str))
-      return reservedWords[i].tok;
+/* uses a perfect hash: one slot, one compare */
+static TokenType reservedLookup (const char * s, int len)
+{ unsigned h = RESERVEDHASH(len,s[0],s[len-1]);
+  if (reservedWords[h].len == len && !memcmp(s,reservedWords[h].str,len))
+    return reservedWords[h].tok;
   return ID;
 }
 
+/* STATSKIP counts the bytes a bulk skip went over
+   since statPos as steps of the DFA from state st to
+   itself, and as comment bytes if comment is TRUE */
+#define STATSKIP(s,st,comment) \
+   SCANSTAT(s->stats->transitions[st][st] += s->linepos - s->statPos; \
+            if (comment) s->stats->commentBytes += s->linepos - s->statPos)
+
 /****************************************/
 /* the primary function of the scanner  */
 /****************************************/
-/* function getToken returns the 
- * next token in source file
+/* function scanToken runs the DFA over the
+ * range of s and returns its next token
  */
-TokenType getToken(void)
+static TokenType scanToken(ScanState * s)
 {  /* index for storing into tokenString */
    int tokenStringIndex = 0;
-   /* holds current token to be returned */
-   TokenType currentToken;
-   /* current state - always begins at START */
-   StateType state = START;
+   /* holds current token to be returned; every path
+      to DONE sets it, ERROR only quiets the compiler */
+   TokenType currentToken = ERROR;
+   /* current state - begins at START except for
+      the first token of a chunk lexed as if it
+      opened inside a comment */
+   StateType state = s->entry;
    /* flag to indicate save to tokenString */
    int save;
+   s->entry = START;
+   s->ungot = FALSE;
    while (state != DONE)
-   { int c = getNextChar();
+   { int c = getNextChar(s);
      save = TRUE;
+     SCANSTAT(s->statFrom = state);
      switch (state)
      { case START:
          if (isdigit(c))
@@ -109,7 +215,12 @@ TokenType getToken(void)
            save = FALSE;
          }
          else if ((c == ' ') || (c == '\t') || (c == '\n'))
-           save = FALSE;
+         { save = FALSE;
+           /* skip the rest of the blank run in bulk */
+           SCANSTAT(s->statPos = s->linepos);
+           s->linepos = skipBlanks(s->lineBuf+s->linepos,s->lineBuf+s->bufsize) - s->lineBuf;
+           STATSKIP(s,START,FALSE);
+         }
          else
          { state = DONE;
            switch (c)
@@ -158,27 +269,41 @@ TokenType getToken(void)
          break;
        case INCOMMENT:
          save = FALSE;
+         SCANSTAT(s->stats->commentBytes += c != EOF);
          if (c == '*')
            state = INCOMMENT_;
          else if (c == EOF)
          { 
            state = DONE;
            currentToken = ENDFILE;
+           s->inComment = TRUE;
          }
          else
-           state = INCOMMENT;
+         { state = INCOMMENT;
+           /* jump to the next '*' on this line */
+           SCANSTAT(s->statPos = s->linepos);
+           s->linepos = findStar(s->lineBuf+s->linepos,s->lineBuf+s->bufsize) - s->lineBuf;
+           STATSKIP(s,INCOMMENT,TRUE);
+         }
          break;
        case INCOMMENT_:
          save = FALSE;
+         SCANSTAT(s->stats->commentBytes += c != EOF);
          if (c == '/')
            state = START;
          else if (c == EOF)
          {
            state = DONE;
            currentToken = ENDFILE;
+           s->inComment = TRUE;
          }
          else
-           state = INCOMMENT;
+         { state = INCOMMENT;
+           /* jump to the next '*' on this line */
+           SCANSTAT(s->statPos = s->linepos);
+           s->linepos = findStar(s->lineBuf+s->linepos,s->lineBuf+s->bufsize) - s->lineBuf;
+           STATSKIP(s,INCOMMENT,TRUE);
+         }
          break;
        case INEQ:
          save = FALSE;
@@ -187,7 +312,7 @@ TokenType getToken(void)
            currentToken = EQ;
          else
          { /* backup in the input */
-           ungetNextChar();
+           ungetNextChar(s);
            currentToken = ASSIGN;
          }
          break;
@@ -200,7 +325,7 @@ TokenType getToken(void)
          }
          else
          { /* backup in the input */
-          ungetNextChar();
+          ungetNextChar(s);
           currentToken = ERROR;
          }
          break;      
@@ -211,7 +336,7 @@ TokenType getToken(void)
            currentToken = LE;
           else 
           { /* backup in the input */
-            ungetNextChar();
+            ungetNextChar(s);
             currentToken = LT;
           }
          break;
@@ -222,17 +347,19 @@ TokenType getToken(void)
            currentToken = GE;
           else 
           { /* backup in the input */
-            ungetNextChar();
+            ungetNextChar(s);
             currentToken = GT;
           }
          break;
        case INOVER:
            save = FALSE;
            if (c == '*')
-             state = INCOMMENT;
+           { state = INCOMMENT;
+             SCANSTAT(s->stats->commentBytes += 2);
+           }
            else 
            { /* backup in the input */
-             ungetNextChar();
+             ungetNextChar(s);
              state = DONE;
              currentToken = OVER;
            }
@@ -240,7 +367,7 @@ TokenType getToken(void)
        case INNUM:
          if (!isdigit(c))
          { /* backup in the input */
-           ungetNextChar();
+           ungetNextChar(s);
            save = FALSE;
            state = DONE;
            currentToken = NUM;
@@ -249,7 +376,7 @@ TokenType getToken(void)
        case INID:
          if (!isalnum(c))
          { /* backup in the input */
-           ungetNextChar();
+           ungetNextChar(s);
            save = FALSE;
            state = DONE;
            currentToken = ID;
@@ -262,18 +389,170 @@ TokenType getToken(void)
          currentToken = ERROR;
          break;
      }
+     SCANSTAT(s->stats->transitions[s->statFrom][state]++);
      if ((save) && (tokenStringIndex <= MAXTOKENLEN))
-       tokenString[tokenStringIndex++] = (char) c;
+     { if (tokenStringIndex == 0)
+         s->tokenText = s->lineBuf + s->linepos - 1;
+       s->tokenString[tokenStringIndex++] = (char) c;
+     }
+     if (state == INID)
+     { /* take the rest of the alnum run in bulk; the
+          character ending it goes through the DFA */
+       const char * run = s->lineBuf + s->linepos;
+       int n = skipAlnum(run,s->lineBuf+s->bufsize) - run;
+       int room = MAXTOKENLEN + 1 - tokenStringIndex;
+       if (room > 0)
+       { memcpy(s->tokenString+tokenStringIndex,run,n < room ? n : room);
+         tokenStringIndex += n < room ? n : room;
+       }
+       s->linepos += n;
+       SCANSTAT(s->stats->transitions[INID][INID] += n);
+     }
      if (state == DONE)
-     { tokenString[tokenStringIndex] = '\0';
+     { s->tokenString[tokenStringIndex] = '\0';
        if (currentToken == ID)
-         currentToken = reservedLookup(tokenString);
+         currentToken = reservedLookup(s->tokenString,tokenStringIndex);
      }
    }
-   if (TraceScan) {
-     fprintf(listing,"\t%d: ",lineno);
-     printToken(currentToken,tokenString);
-   }
+   s->tokenLen = tokenStringIndex;
    return currentToken;
+} /* end scanToken */
+
+/* tokenEnd returns the offset in the range of s of
+   the last character the DFA fetched for its token */
+#define tokenEnd(s) ((s)->linepos - 1 + (s)->ungot)
+
+/* tokenEOFs returns how many EOFs a lazy scan has
+   fetched: after the one fetch of the whole range
+   every fetch is an EOF */
+#define tokenEOFs(s) ((s)->EOF_flag ? (s)->lineno - ((s)->len > 0) : 0)
+
+/* tokenLine returns the line getNextChar would have
+   counted for a token of a lazy scan: the line of
+   its last fetched character pos (a file offset),
+   or once EOF is reached, one line past the last
+   line for every EOF fetched */
+static int tokenLine(size_t pos, int eofs)
+{ if (eofs > 0)
+    return lines.count + eofs +
+           (srcBuf.len > 0 && srcBuf.text[srcBuf.len-1] != '\n');
+  return LINEOF(&lines,pos);
+}
+
+/* lexChunk lexes chunk c on its own ScanState,
+   starting inside a comment if c->guess says so */
+int lexChunk(ScanChunk * c, int last)
+{ char lexeme[MAXTOKENLEN+2];
+#if SCAN_STATS
+  ScanStats chunkStats;
+#endif
+  ScanState s = { NULL, 0, 0, FALSE, c->text, c->len, NULL, FALSE, 0, TRUE, 0,
+                  FALSE, lexeme, NULL, 0, c->guess ? INCOMMENT : START, FALSE
+#if SCAN_STATS
+                  , &chunkStats, START, 0
+#endif
+                };
+  TokenType token;
+  SCANSTAT(memset(&chunkStats,0,sizeof chunkStats));
+  c->ntokens = 0;
+  while ((token = scanToken(&s)) != ENDFILE || last)
+  { ChunkToken * t;
+    if (c->ntokens == c->capacity)
+    { int capacity = c->capacity ? 2 * c->capacity : 1024;
+      ChunkToken * bigger = realloc(c->tokens,capacity * sizeof(ChunkToken));
+      if (bigger == NULL) return FALSE;
+      c->tokens = bigger;
+      c->capacity = capacity;
+    }
+    t = c->tokens + c->ntokens++;
+    t->token = token;
+    t->endpos = tokenEnd(&s);
+    t->eofs = tokenEOFs(&s);
+    t->len = s.tokenLen;
+    t->offset = s.tokenLen ? s.tokenText - c->text : 0;
+    if (token == ENDFILE) break;
+  }
+  c->inComment = s.inComment;
+  SCANSTAT(statsMerge(s.stats));
+  return TRUE;
+}
+
+/* startInput loads the source on the first call to
+   getToken. Unless the lines are echoed, which needs
+   them fetched one by one, it indexes the newlines
+   so the scan can run lazy, and when the file is
+   large enough lexes it in parallel up front. A
+   source that cannot be mapped (a pipe) is streamed
+   through a ring, in constant memory */
+static void startInput(void)
+{ srcLoaded = TRUE;
+  SCANSTAT(statsBegin("scan.c","START INCOMMENT INCOMMENT_ INEQ INNE INLT "
+                      "INGT INOVER INNUM INID DONE");
+           statsPhase(STAT_LOAD));
+  initSimd();
+  if (!BufferSource) return;
+  if (loadSource(source,&srcBuf))
+  { serial.text = srcBuf.text;
+    serial.len = srcBuf.len;
+    if (!EchoSource && buildLineIndex(&lines,srcBuf.text,srcBuf.len))
+    { serial.lazy = TRUE;
+      if (ParallelScan)
+        chunks = parallelLex(srcBuf.text,srcBuf.len,&nchunks);
+    }
+  }
+  else if (openRing(source,&srcRing))
+    serial.ring = &srcRing;
+}
+
+/* nextChunkToken replays the merged token stream of
+   the parallel chunks, staying on the final ENDFILE */
+static TokenType nextChunkToken(void)
+{ ScanChunk * c = chunks + curChunk;
+  ChunkToken * t;
+  while (curToken == c->ntokens)
+  { curChunk++;
+    curToken = 0;
+    c++;
+  }
+  t = c->tokens + curToken;
+  if (curChunk < nchunks - 1 || curToken < c->ntokens - 1) curToken++;
+  memcpy(tokenString,c->text + t->offset,t->len);
+  tokenString[t->len] = '\0';
+  tokenOffset = (c->text - srcBuf.text) + t->offset;
+  tokenLength = t->len;
+  lineno = tokenLine((c->text - srcBuf.text) + t->endpos,t->eofs);
+  return t->token;
+}
+
+/* function getToken returns the 
+ * next token in source file
+ */
+TokenType getToken(void)
+{ TokenType currentToken;
+  if (!srcLoaded) startInput();
+  SCANSTAT(statsPhase(STAT_SCAN));
+  if (chunks != NULL)
+    currentToken = nextChunkToken();
+  else
+  { currentToken = scanToken(&serial);
+    lineno = serial.lazy ? tokenLine(tokenEnd(&serial),tokenEOFs(&serial))
+                         : serial.lineno;
+    if (serial.text != NULL)
+    { tokenOffset = serial.tokenLen ? serial.tokenText - srcBuf.text : 0;
+      tokenLength = serial.tokenLen;
+    }
+  }
+  SCANSTAT(statsToken(currentToken); statsPhase(STAT_TRACE));
+  if (TraceScan) {
+    if (BinaryTrace)
+      traceToken(currentToken,lineno,tokenOffset,tokenString,
+                 tokenOffset < 0 ? (int) strlen(tokenString) : tokenLength);
+    else
+    { fprintf(listing,"\t%d: ",lineno);
+      printToken(currentToken,tokenString);
+    }
+  }
+  SCANSTAT(statsPhase(STAT_OUTSIDE));
+  return currentToken;
 } /* end getToken */
 
@@ -11,8 +11,9 @@
 /* MAXTOKENLEN is the maximum size of a token */
 #define MAXTOKENLEN 40
 
-/* tokenString array stores the lexeme of each token */
-extern char tokenString[MAXTOKENLEN+1];
+/* tokenString array stores the lexeme of each token,
+   which the scanners cut at MAXTOKENLEN+1 characters */
+extern char tokenString[MAXTOKENLEN+2];
 
 /* function getToken returns the 
  * next token in source file
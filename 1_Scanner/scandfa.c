@@ -0,0 +1,78 @@
+/****************************************************/
+/* File: scandfa.c                                  */
+/* getToken on the direct-coded DFA that mkdfa      */
+/* generates from tokens.txt                        */
+/****************************************************/
+
+#include "globals.h"
+#include "util.h"
+#include "scan.h"
+#include "source.h"
+#include "lines.h"
+#include "tracebin.h"
+
+/* dfaScan is generated from tokens.txt and
+   reserved.txt by mkdfa */
+#include "dfa.h"
+
+/* lexeme of identifier or reserved word */
+char tokenString[MAXTOKENLEN+2];
+
+/* the whole source, NUL-terminated for dfaScan,
+   and the scan position in it */
+static SourceBuf srcBuf;
+static const unsigned char * pos = NULL;
+static int eofs = 0; /* sentinel reads so far */
+
+/* newlines of srcBuf, for the token lines */
+static LineIndex lines;
+
+/* startInput reads the whole source, pipes too, and
+   indexes its newlines. Lines are not echoed: the
+   scan never splits the text into lines */
+static void startInput(void)
+{ if (!readSource(source,&srcBuf) ||
+      !buildLineIndex(&lines,srcBuf.text,srcBuf.len))
+  { fprintf(stderr,"Out of memory reading the source\n");
+    exit(1);
+  }
+  pos = (const unsigned char *) srcBuf.text;
+}
+
+/* function getToken returns the
+ * next token in source file
+ */
+TokenType getToken(void)
+{ const unsigned char * text = (const unsigned char *) srcBuf.text;
+  const unsigned char * start;
+  TokenType currentToken;
+  size_t len;
+  if (pos == NULL)
+  { startInput();
+    text = (const unsigned char *) srcBuf.text;
+  }
+  currentToken = dfaScan(&pos,text + srcBuf.len,&start,&eofs);
+  /* keep what scan.c keeps: up to MAXTOKENLEN+1
+     bytes of the lexeme */
+  len = currentToken == ENDFILE ? 0 : pos - start;
+  if (len > MAXTOKENLEN + 1) len = MAXTOKENLEN + 1;
+  memcpy(tokenString,start,len);
+  tokenString[len] = '\0';
+  /* a token never holds a newline, so its first byte
+     has its line; at the end of the text every read
+     of the sentinel counts a line, as in scan.c */
+  if (eofs > 0)
+    lineno = lines.count + eofs +
+             (srcBuf.len > 0 && srcBuf.text[srcBuf.len-1] != '\n');
+  else
+    lineno = LINEOF(&lines,(size_t) (start - text));
+  if (TraceScan) {
+    if (BinaryTrace)
+      traceToken(currentToken,lineno,start - text,tokenString,len);
+    else
+    { fprintf(listing,"\t%d: ",lineno);
+      printToken(currentToken,tokenString);
+    }
+  }
+  return currentToken;
+} /* end getToken */
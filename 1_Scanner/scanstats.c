@@ -0,0 +1,121 @@
+/****************************************************/
+/* File: scanstats.c                                */
+/* Scanner statistics: token, DFA and time counters */
+/* reported at exit by SCAN_STATS builds            */
+/****************************************************/
+
+#include <time.h>
+
+#include "globals.h"
+#include "scan.h"
+#include "scanstats.h"
+
+ScanStats scanStats;
+
+static const char * scannerName = "";
+static char stateText[256];
+static const char * stateNames[MAXSTATSTATES];
+static int nstates = 0; /* 0 if the scanner names none */
+
+static StatPhase phase = STAT_OUTSIDE;
+static double phaseStart = 0;
+
+static const char * const tokenNames[] =
+   { "ENDFILE", "ERROR", "IF", "ELSE", "WHILE", "RETURN", "INT", "VOID",
+     "ID", "NUM", "ASSIGN", "EQ", "NE", "LT", "LE", "GT", "GE", "PLUS",
+     "MINUS", "TIMES", "OVER", "LPAREN", "RPAREN", "LBRACE", "RBRACE",
+     "LCURLY", "RCURLY", "SEMI", "COMMA" };
+
+static const char * const phaseNames[NSTATPHASES] =
+   { "load", "scan", "trace", "outside" };
+
+static double now(void)
+{ struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* writeReport writes the counters to stderr as one
+   JSON object; counters that are all zero are left
+   out of their maps */
+static void writeReport(void)
+{ long total = 0;
+  double scanned;
+  int i, j, first;
+  statsPhase(STAT_OUTSIDE);
+  for (i = 0; i <= COMMA; i++) total += scanStats.tokens[i];
+  scanned = scanStats.seconds[STAT_LOAD] + scanStats.seconds[STAT_SCAN];
+  fprintf(stderr,"{\"scanner\": \"%s\", \"bytes\": %ld, \"tokens\": %ld,\n",
+          scannerName,scanStats.bytes,total);
+  fprintf(stderr," \"seconds\": {");
+  for (i = 0; i < NSTATPHASES; i++)
+    fprintf(stderr,"%s\"%s\": %.6f",i ? ", " : "",phaseNames[i],scanStats.seconds[i]);
+  fprintf(stderr,"},\n \"bytes_per_second\": %.0f, \"comment_bytes\": %ld,\n",
+          scanned > 0 ? scanStats.bytes / scanned : 0.0,scanStats.commentBytes);
+  fprintf(stderr," \"token_kinds\": {");
+  for (i = 0, first = TRUE; i <= COMMA; i++)
+    if (scanStats.tokens[i] > 0)
+    { fprintf(stderr,"%s\"%s\": %ld",first ? "" : ", ",tokenNames[i],scanStats.tokens[i]);
+      first = FALSE;
+    }
+  fprintf(stderr,"},\n \"id_lengths\": {");
+  for (i = 1, first = TRUE; i <= MAXTOKENLEN + 1; i++)
+    if (scanStats.idLengths[i] > 0)
+    { fprintf(stderr,"%s\"%d%s\": %ld",first ? "" : ", ",i,
+              i > MAXTOKENLEN ? "+" : "",scanStats.idLengths[i]);
+      first = FALSE;
+    }
+  fprintf(stderr,"},\n");
+  if (nstates == 0)
+    fprintf(stderr," \"ungets\": null, \"transitions\": null}\n");
+  else
+  { fprintf(stderr," \"ungets\": %ld, \"transitions\": {",scanStats.ungets);
+    for (i = 0, first = TRUE; i < nstates; i++)
+      for (j = 0; j < nstates; j++)
+        if (scanStats.transitions[i][j] > 0)
+        { fprintf(stderr,"%s\n  \"%s>%s\": %ld",first ? "" : ",",
+                  stateNames[i],stateNames[j],scanStats.transitions[i][j]);
+          first = FALSE;
+        }
+    fprintf(stderr,"}}\n");
+  }
+}
+
+void statsBegin(const char * scanner, const char * states)
+{ char * p;
+  scannerName = scanner;
+  if (states != NULL)
+  { strncpy(stateText,states,sizeof stateText - 1);
+    for (p = strtok(stateText," "); p != NULL && nstates < MAXSTATSTATES; p = strtok(NULL," "))
+      stateNames[nstates++] = p;
+  }
+  phaseStart = now();
+  atexit(writeReport);
+}
+
+void statsPhase(StatPhase next)
+{ double t = now();
+  scanStats.seconds[phase] += t - phaseStart;
+  phaseStart = t;
+  phase = next;
+}
+
+void statsToken(TokenType token)
+{ scanStats.tokens[token]++;
+  if (token == ID)
+  { size_t len = strlen(tokenString);
+    scanStats.idLengths[len > MAXTOKENLEN ? MAXTOKENLEN + 1 : len]++;
+  }
+}
+
+void statsMerge(const ScanStats * chunk)
+{ int i, j;
+  __atomic_fetch_add(&scanStats.bytes,chunk->bytes,__ATOMIC_RELAXED);
+  __atomic_fetch_add(&scanStats.commentBytes,chunk->commentBytes,__ATOMIC_RELAXED);
+  __atomic_fetch_add(&scanStats.ungets,chunk->ungets,__ATOMIC_RELAXED);
+  for (i = 0; i < MAXSTATSTATES; i++)
+    for (j = 0; j < MAXSTATSTATES; j++)
+      if (chunk->transitions[i][j] > 0)
+        __atomic_fetch_add(&scanStats.transitions[i][j],chunk->transitions[i][j],
+                           __ATOMIC_RELAXED);
+}
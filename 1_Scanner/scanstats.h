@@ -0,0 +1,82 @@
+/****************************************************/
+/* File: scanstats.h                                */
+/* Scanner statistics: token, DFA and time counters */
+/* reported at exit by SCAN_STATS builds            */
+/****************************************************/
+
+#ifndef _SCANSTATS_H_
+#define _SCANSTATS_H_
+
+/* set SCAN_STATS to TRUE to compile the counters into
+   the scanners (as the cminus_cimpl_stats and
+   cminus_lex_stats targets do). Otherwise SCANSTAT
+   drops its argument unseen: nothing is counted and
+   no code is left behind */
+#ifndef SCAN_STATS
+#define SCAN_STATS FALSE
+#endif
+
+#if SCAN_STATS
+#define SCANSTAT(...) do { __VA_ARGS__; } while (0)
+#else
+#define SCANSTAT(...) ((void) 0)
+#endif
+
+/* MAXSTATSTATES = the most DFA states a scanner can
+   name for its transition counts */
+#define MAXSTATSTATES 16
+
+/* the phases the scanner time is split into: loading
+   the source (in scan.c with the parallel lexing it
+   starts), scanning tokens, listing them, and the
+   time outside getToken */
+typedef enum { STAT_LOAD, STAT_SCAN, STAT_TRACE, STAT_OUTSIDE, NSTATPHASES }
+   StatPhase;
+
+/* ScanStats holds the counters. tokens and idLengths
+ * count the tokens getToken hands out; the rest count
+ * the work of the DFA, so in parallel mode they take
+ * in the chunks lexed again after a wrong comment
+ * guess. A bulk skip (of blanks, an identifier, a
+ * comment up to its next star) counts as a step of
+ * the DFA per byte skipped
+ */
+typedef struct
+   { long tokens[COMMA+1]; /* by TokenType */
+     long idLengths[MAXTOKENLEN+2]; /* the last counts cut lexemes */
+     long bytes; /* of source the DFA went over */
+     long commentBytes; /* from each opening slash to the closing one */
+     long ungets; /* ungetNextChar backtracks */
+     long transitions[MAXSTATSTATES][MAXSTATSTATES]; /* from, to */
+     double seconds[NSTATPHASES];
+   } ScanStats;
+
+/* the counters of the scan, or of one parallel chunk */
+extern ScanStats scanStats;
+
+/* Procedure statsBegin starts the counts for the
+ * scanner named scanner, whose DFA states are named
+ * in states, space separated in enum order. A scanner
+ * with no states to show passes NULL, and gets no
+ * transitions or ungets in its report. The report is
+ * written to stderr at exit
+ */
+void statsBegin(const char * scanner, const char * states);
+
+/* Procedure statsPhase charges the time since the
+ * last call to the phase then running, and starts
+ * phase
+ */
+void statsPhase(StatPhase phase);
+
+/* Procedure statsToken counts a token handed out,
+ * with the lexeme in tokenString
+ */
+void statsToken(TokenType token);
+
+/* Procedure statsMerge adds the DFA counters of a
+ * chunk lexed on its own thread to scanStats
+ */
+void statsMerge(const ScanStats * chunk);
+
+#endif
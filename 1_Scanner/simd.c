@@ -0,0 +1,165 @@
+/****************************************************/
+/* File: simd.c                                     */
+/* Vectorized run-skipping kernels for the scanner  */
+/****************************************************/
+
+#include "globals.h"
+#include "simd.h"
+
+#if !defined(NO_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#define HAVE_SSE2
+#include <emmintrin.h>
+#if !defined(NO_AVX2) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/* ALNUM tests one byte without locale lookups; it
+   agrees with isalnum() in the "C" locale */
+#define ALNUM(c) ((unsigned)((c)-'0') < 10 || \
+                  (unsigned)(((c)|0x20)-'a') < 26)
+
+/**************************************************/
+/***********   Scalar kernels          ************/
+/**************************************************/
+
+static const char * scalarBlanks(const char * p, const char * end)
+{ while (p < end && (*p == ' ' || *p == '\t')) p++;
+  return p;
+}
+
+static const char * scalarStar(const char * p, const char * end)
+{ while (p < end && *p != '*') p++;
+  return p;
+}
+
+static const char * scalarAlnum(const char * p, const char * end)
+{ while (p < end && ALNUM((unsigned char) *p)) p++;
+  return p;
+}
+
+const char * (*skipBlanks)(const char *, const char *) = scalarBlanks;
+const char * (*findStar)(const char *, const char *) = scalarStar;
+const char * (*skipAlnum)(const char *, const char *) = scalarAlnum;
+
+/**************************************************/
+/***********   SSE2 kernels (16 bytes)  ***********/
+/**************************************************/
+
+#ifdef HAVE_SSE2
+
+/* The vector bodies compute a bit mask with one bit
+   set per byte that ENDS the run, then jump to the
+   lowest set bit; the tail goes through the scalar
+   loop so no load crosses end */
+
+static const char * sse2Blanks(const char * p, const char * end)
+{ const __m128i sp = _mm_set1_epi8(' '), tab = _mm_set1_epi8('\t');
+  while (end - p >= 16)
+  { __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i in = _mm_or_si128(_mm_cmpeq_epi8(v,sp),_mm_cmpeq_epi8(v,tab));
+    unsigned stop = ~(unsigned) _mm_movemask_epi8(in) & 0xffff;
+    if (stop) return p + __builtin_ctz(stop);
+    p += 16;
+  }
+  return scalarBlanks(p,end);
+}
+
+static const char * sse2Star(const char * p, const char * end)
+{ const __m128i star = _mm_set1_epi8('*');
+  while (end - p >= 16)
+  { __m128i v = _mm_loadu_si128((const __m128i *) p);
+    unsigned stop = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(v,star));
+    if (stop) return p + __builtin_ctz(stop);
+    p += 16;
+  }
+  return scalarStar(p,end);
+}
+
+/* signed byte compares: bytes >= 0x80 are negative
+   and fall outside both ranges */
+static const char * sse2Alnum(const char * p, const char * end)
+{ const __m128i d0 = _mm_set1_epi8('0'-1), d9 = _mm_set1_epi8('9'+1);
+  const __m128i la = _mm_set1_epi8('a'-1), lz = _mm_set1_epi8('z'+1);
+  const __m128i fold = _mm_set1_epi8(0x20);
+  while (end - p >= 16)
+  { __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i l = _mm_or_si128(v,fold);
+    __m128i dig = _mm_and_si128(_mm_cmpgt_epi8(v,d0),_mm_cmplt_epi8(v,d9));
+    __m128i let = _mm_and_si128(_mm_cmpgt_epi8(l,la),_mm_cmplt_epi8(l,lz));
+    unsigned stop = ~(unsigned) _mm_movemask_epi8(_mm_or_si128(dig,let)) & 0xffff;
+    if (stop) return p + __builtin_ctz(stop);
+    p += 16;
+  }
+  return scalarAlnum(p,end);
+}
+
+#endif
+
+/**************************************************/
+/***********   AVX2 kernels (32 bytes)  ***********/
+/**************************************************/
+
+#ifdef HAVE_AVX2
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static const char * avx2Blanks(const char * p, const char * end)
+{ const __m256i sp = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+  while (end - p >= 32)
+  { __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i in = _mm256_or_si256(_mm256_cmpeq_epi8(v,sp),_mm256_cmpeq_epi8(v,tab));
+    unsigned stop = ~(unsigned) _mm256_movemask_epi8(in);
+    if (stop) return p + __builtin_ctz(stop);
+    p += 32;
+  }
+  return sse2Blanks(p,end);
+}
+
+AVX2 static const char * avx2Star(const char * p, const char * end)
+{ const __m256i star = _mm256_set1_epi8('*');
+  while (end - p >= 32)
+  { __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    unsigned stop = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v,star));
+    if (stop) return p + __builtin_ctz(stop);
+    p += 32;
+  }
+  return sse2Star(p,end);
+}
+
+AVX2 static const char * avx2Alnum(const char * p, const char * end)
+{ const __m256i d0 = _mm256_set1_epi8('0'-1), d9 = _mm256_set1_epi8('9'+1);
+  const __m256i la = _mm256_set1_epi8('a'-1), lz = _mm256_set1_epi8('z'+1);
+  const __m256i fold = _mm256_set1_epi8(0x20);
+  while (end - p >= 32)
+  { __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i l = _mm256_or_si256(v,fold);
+    __m256i dig = _mm256_and_si256(_mm256_cmpgt_epi8(v,d0),_mm256_cmpgt_epi8(d9,v));
+    __m256i let = _mm256_and_si256(_mm256_cmpgt_epi8(l,la),_mm256_cmpgt_epi8(lz,l));
+    unsigned stop = ~(unsigned) _mm256_movemask_epi8(_mm256_or_si256(dig,let));
+    if (stop) return p + __builtin_ctz(stop);
+    p += 32;
+  }
+  return sse2Alnum(p,end);
+}
+
+#endif
+
+void initSimd(void)
+{
+#ifdef HAVE_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  { skipBlanks = avx2Blanks;
+    findStar = avx2Star;
+    skipAlnum = avx2Alnum;
+    return;
+  }
+#endif
+#ifdef HAVE_SSE2
+  skipBlanks = sse2Blanks;
+  findStar = sse2Star;
+  skipAlnum = sse2Alnum;
+#endif
+}
@@ -0,0 +1,28 @@
+/****************************************************/
+/* File: simd.h                                     */
+/* Vectorized run-skipping kernels for the scanner  */
+/****************************************************/
+
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+/* Each kernel scans the bytes [p,end) and returns a
+ * pointer to the first byte that ends the run, or
+ * end if the whole range belongs to it:
+ *   skipBlanks - run of ' ' and '\t'
+ *   findStar   - run of bytes other than '*'
+ *   skipAlnum  - run of [A-Za-z0-9]
+ * The pointers start out at portable scalar versions
+ */
+extern const char * (*skipBlanks)( const char * p, const char * end );
+extern const char * (*findStar)( const char * p, const char * end );
+extern const char * (*skipAlnum)( const char * p, const char * end );
+
+/* Procedure initSimd points the kernels at the widest
+ * implementation the CPU supports (AVX2, then SSE2).
+ * Building with NO_SIMD keeps the scalar versions,
+ * NO_AVX2 stops at SSE2
+ */
+void initSimd( void );
+
+#endif
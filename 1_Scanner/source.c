@@ -0,0 +1,132 @@
+/****************************************************/
+/* File: source.c                                   */
+/* Source buffers for the scanner: whole mapped     */
+/* files and fixed-size rings for streamed input    */
+/****************************************************/
+
+#include "globals.h"
+#include "source.h"
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* RINGSIZE = size of the buffer streamed input
+   goes through; it bounds the memory a scan of a
+   pipe takes, however long the input is */
+#ifndef RINGSIZE
+#define RINGSIZE 65536
+#endif
+
+int loadSource(FILE * f, SourceBuf * sb)
+{ struct stat st;
+  off_t pos;
+  char * base;
+  if (fstat(fileno(f),&st) < 0 || !S_ISREG(st.st_mode))
+    return FALSE;
+  pos = ftello(f);
+  if (pos < 0 || pos > st.st_size) return FALSE;
+  if (st.st_size == pos)
+  { /* mmap refuses empty mappings */
+    sb->text = "";
+    sb->len = 0;
+    sb->base = NULL;
+    sb->size = 0;
+    sb->mapped = FALSE;
+    return TRUE;
+  }
+  base = mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fileno(f),0);
+  if (base == MAP_FAILED) return FALSE;
+  madvise(base,st.st_size,MADV_SEQUENTIAL);
+  sb->text = base + pos;
+  sb->len = st.st_size - pos;
+  sb->base = base;
+  sb->size = st.st_size;
+  sb->mapped = TRUE;
+  return TRUE;
+}
+
+void freeSource(SourceBuf * sb)
+{ if (sb->mapped) munmap(sb->base,sb->size);
+  else free(sb->base);
+  sb->text = NULL;
+  sb->len = 0;
+  sb->base = NULL;
+  sb->size = 0;
+  sb->mapped = FALSE;
+}
+
+int openRing(FILE * f, SourceRing * r)
+{ r->ring = malloc(RINGSIZE);
+  r->head = r->tail = 0;
+  r->fd = fileno(f);
+  r->eof = FALSE;
+  return r->ring != NULL;
+}
+
+/* fillRing reads whatever the source has ready into
+   the ring after its tail, wrapping to the start of
+   the ring when the tail has reached its end; only
+   called once the ring has been handed out */
+static int fillRing(SourceRing * r)
+{ ssize_t n;
+  if (r->eof) return FALSE;
+  if (r->tail == RINGSIZE) r->head = r->tail = 0;
+  do n = read(r->fd,r->ring + r->tail,RINGSIZE - r->tail);
+  while (n < 0 && errno == EINTR);
+  if (n <= 0)
+  { r->eof = TRUE;
+    return FALSE;
+  }
+  r->tail += n;
+  return TRUE;
+}
+
+int ringLine(SourceRing * r, const char ** piece, int * len)
+{ const char * nl;
+  size_t n;
+  if (r->head == r->tail && !fillRing(r)) return FALSE;
+  *piece = r->ring + r->head;
+  nl = memchr(*piece,'\n',r->tail - r->head);
+  n = nl ? (size_t) (nl - *piece) + 1 : r->tail - r->head;
+  r->head += n;
+  *len = n;
+  return TRUE;
+}
+
+void closeRing(SourceRing * r)
+{ free(r->ring);
+  r->ring = NULL;
+  r->head = r->tail = 0;
+}
+
+int readSource(FILE * f, SourceBuf * sb)
+{ size_t capacity = 65536, len = 0, n;
+  char * text = malloc(capacity + 1);
+  if (text == NULL) return FALSE;
+  while ((n = fread(text + len,1,capacity - len,f)) > 0)
+  { len += n;
+    if (len == capacity)
+    { char * bigger = realloc(text,2 * capacity + 1);
+      if (bigger == NULL)
+      { free(text);
+        return FALSE;
+      }
+      text = bigger;
+      capacity *= 2;
+    }
+  }
+  if (ferror(f))
+  { free(text);
+    return FALSE;
+  }
+  text[len] = '\0';
+  sb->text = text;
+  sb->len = len;
+  sb->base = text;
+  sb->size = capacity + 1;
+  sb->mapped = FALSE;
+  return TRUE;
+}
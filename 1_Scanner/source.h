@@ -0,0 +1,74 @@
+/****************************************************/
+/* File: source.h                                   */
+/* Source buffers for the scanner: whole mapped     */
+/* files and fixed-size rings for streamed input    */
+/****************************************************/
+
+#ifndef _SOURCE_H_
+#define _SOURCE_H_
+
+/* SourceBuf holds the complete text of a source
+ * file, mapped from the file
+ */
+typedef struct
+   { const char * text;
+     size_t len;
+     char * base; /* storage to release, NULL if none */
+     size_t size;
+     int mapped; /* TRUE if base must be munmap'ed */
+   } SourceBuf;
+
+/* Function loadSource maps the remainder of file f
+ * into memory. Returns FALSE if f is not a regular
+ * file (pipes, terminals) or cannot be mapped, so
+ * the caller streams it instead
+ */
+int loadSource( FILE * f, SourceBuf * sb );
+
+/* Function readSource reads the rest of file f, of
+ * any kind, into a heap buffer and puts a NUL after
+ * the text, for a scanner that runs up to a sentinel.
+ * Returns FALSE if out of memory or on a read error
+ */
+int readSource( FILE * f, SourceBuf * sb );
+
+/* Procedure freeSource releases a buffer obtained
+ * from loadSource or readSource
+ */
+void freeSource( SourceBuf * sb );
+
+/* SourceRing streams a source of any length through
+ * a buffer of RINGSIZE bytes: reads go in after the
+ * last byte read and wrap to the start of the ring
+ * once everything in it has been handed out
+ */
+typedef struct
+   { char * ring;
+     size_t head; /* next byte to hand out */
+     size_t tail; /* end of the bytes read */
+     int fd;
+     int eof;
+   } SourceRing;
+
+/* Function openRing prepares to stream the rest of
+ * file f, which must not have been read through its
+ * stdio buffer. Returns FALSE if out of memory
+ */
+int openRing( FILE * f, SourceRing * r );
+
+/* Function ringLine hands out the next piece of the
+ * stream: its bytes up to and including the next
+ * newline, or all the bytes the ring holds if no
+ * newline is among them (a line that straddles a
+ * refill comes in several pieces). The piece stays
+ * valid until the next call. Returns FALSE at end
+ * of file or on a read error
+ */
+int ringLine( SourceRing * r, const char ** piece, int * len );
+
+/* Procedure closeRing releases a ring obtained from
+ * openRing
+ */
+void closeRing( SourceRing * r );
+
+#endif
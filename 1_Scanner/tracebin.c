@@ -0,0 +1,98 @@
+/****************************************************/
+/* File: tracebin.c                                 */
+/* Binary token trace: the TraceScan listing as     */
+/* compact records, rendered back by trdump         */
+/****************************************************/
+
+#include "globals.h"
+#include "scan.h"
+#include "tracebin.h"
+
+/* TRACEBUFSIZE = bytes of records gathered before
+   they are written out in one piece */
+#ifndef TRACEBUFSIZE
+#define TRACEBUFSIZE (1 << 20)
+#endif
+
+/* MAXRECORD = the longest record: a token byte, two
+   varints of a long and one of an int, and a lexeme
+   of at most MAXTOKENLEN+1 bytes */
+#define MAXRECORD (1 + 10 + 10 + 5 + MAXTOKENLEN + 1)
+
+static unsigned char * buf = NULL;
+static size_t used = 0;
+static const char * program;
+static int mode = -1; /* no header written yet */
+static int lastLine = 0;
+static long lastOffset = 0;
+
+static unsigned char * putVarint(unsigned char * p, unsigned long v)
+{ while (v >= 0x80)
+  { *p++ = (unsigned char) (v | 0x80);
+    v >>= 7;
+  }
+  *p++ = (unsigned char) v;
+  return p;
+}
+
+static void flushTrace(void)
+{ if (used > 0) fwrite(buf,1,used,listing);
+  used = 0;
+}
+
+/* writeHeader starts the trace in mode m; the name
+   goes straight out, so it may be of any length */
+static void writeHeader(int m)
+{ unsigned char head[16], * p = head;
+  size_t len = strlen(program);
+  mode = m;
+  memcpy(p,TRACEMAGIC,4);
+  p += 4;
+  *p++ = TRACEVERSION;
+  *p++ = (unsigned char) m;
+  p = putVarint(p,len);
+  fwrite(head,1,p - head,listing);
+  fwrite(program,1,len,listing);
+}
+
+static void endTrace(void)
+{ if (mode < 0) writeHeader(TRACE_INLINE);
+  flushTrace();
+  fflush(listing);
+}
+
+void traceStart(const char * pgm)
+{ buf = malloc(TRACEBUFSIZE);
+  if (buf == NULL)
+  { fprintf(stderr,"Out of memory\n");
+    exit(1);
+  }
+  program = pgm;
+  atexit(endTrace);
+}
+
+void traceToken(TokenType token, int line, long offset,
+                const char * lexeme, int len)
+{ unsigned char * p;
+  if (mode < 0) /* standard input cannot be read back */
+    writeHeader(offset < 0 || strcmp(program,"-") == 0 ? TRACE_INLINE : TRACE_SOURCE);
+  if (used > TRACEBUFSIZE - MAXRECORD) flushTrace();
+  p = buf + used;
+  *p++ = (unsigned char) token;
+  p = putVarint(p,ZIGZAG((long) line - lastLine));
+  lastLine = line;
+  if (TRACELEXEME(token))
+  { if (len > MAXTOKENLEN + 1) len = MAXTOKENLEN + 1;
+    if (mode == TRACE_SOURCE)
+    { p = putVarint(p,ZIGZAG(offset - lastOffset));
+      lastOffset = offset;
+      p = putVarint(p,len);
+    }
+    else
+    { p = putVarint(p,len);
+      memcpy(p,lexeme,len);
+      p += len;
+    }
+  }
+  used = p - buf;
+}
@@ -0,0 +1,63 @@
+/****************************************************/
+/* File: tracebin.h                                 */
+/* Binary token trace: the TraceScan listing as     */
+/* compact records, rendered back by trdump         */
+/****************************************************/
+
+#ifndef _TRACEBIN_H_
+#define _TRACEBIN_H_
+
+/* A binary trace is a header and then one record
+ * per token:
+ *
+ *   header  TRACEMAGIC, a version byte, a mode byte,
+ *           and the program name as a varint length
+ *           and its bytes
+ *   record  the token as a byte, a varint line delta
+ *           and, for the tokens TRACELEXEME picks,
+ *           the lexeme: in TRACE_SOURCE mode a varint
+ *           offset delta and a varint length, in
+ *           TRACE_INLINE mode a varint length and the
+ *           bytes themselves
+ *
+ * Varints are little-endian base 128. Deltas are from
+ * the previous record and zigzag-coded, so they may
+ * be negative. TRACE_SOURCE offsets are file offsets
+ * into the source, which trdump reads back to get the
+ * lexemes; a scan that does not hold the whole source,
+ * or that reads standard input, writes TRACE_INLINE
+ */
+#define TRACEMAGIC "CMTB"
+#define TRACEVERSION 1
+
+#define TRACE_SOURCE 0
+#define TRACE_INLINE 1
+
+/* TRACELEXEME tells whether the listing of token t
+   shows its lexeme */
+#define TRACELEXEME(t) ((t) == ID || (t) == NUM || (t) == ERROR)
+
+/* ZIGZAG maps a delta d to an unsigned varint value,
+   small for small d of either sign; UNZIGZAG undoes
+   it. Both use their argument more than once */
+#define ZIGZAG(d) ((d) < 0 ? ((unsigned long) -((d) + 1) << 1) | 1 \
+                           : (unsigned long) (d) << 1)
+#define UNZIGZAG(v) ((v) & 1 ? -(long) ((v) >> 1) - 1 : (long) ((v) >> 1))
+
+/* Procedure traceStart begins a binary trace of
+ * program pgm on the listing file, in place of the
+ * banner of the text listing. The trace is flushed
+ * at exit
+ */
+void traceStart( const char * pgm );
+
+/* Procedure traceToken adds the record of token at
+ * line. Its lexeme is the len bytes at lexeme, which
+ * lie at offset in the source, or -1 if the scanner
+ * cannot tell; the first record fixes the mode, so
+ * a scanner passes offsets for all tokens or none
+ */
+void traceToken( TokenType token, int line, long offset,
+                 const char * lexeme, int len );
+
+#endif
@@ -0,0 +1,178 @@
+/****************************************************/
+/* File: trdump.c                                   */
+/* Renders a binary token trace (see tracebin.h)    */
+/* as the text listing of TraceScan                 */
+/****************************************************/
+
+/* usage: trdump <trace> [source]
+ *
+ * Writes to standard output exactly what the scanner
+ * would have listed with the binary trace off. A
+ * TRACE_SOURCE trace needs the source it was taken
+ * from, by default the file named in its header
+ */
+
+#include "globals.h"
+#include "scan.h"
+#include "tracebin.h"
+
+/* OUTBUFSIZE = bytes of listing gathered before they
+   are written out in one piece */
+#define OUTBUFSIZE (1 << 20)
+
+/* MAXLINE = the longest listing line: a tab, a line
+   number, the text of a token and its lexeme */
+#define MAXLINE 96
+
+/* what the listing shows for each token, before the
+   lexeme for the tokens TRACELEXEME picks */
+static const char * const tokenText[] =
+   { [ENDFILE] = "EOF\n", [ERROR] = "ERROR: ",
+     [IF] = "reserved word: if\n", [ELSE] = "reserved word: else\n",
+     [WHILE] = "reserved word: while\n", [RETURN] = "reserved word: return\n",
+     [INT] = "reserved word: int\n", [VOID] = "reserved word: void\n",
+     [ID] = "ID, name= ", [NUM] = "NUM, val= ",
+     [ASSIGN] = "=\n", [EQ] = "==\n", [NE] = "!=\n", [LT] = "<\n",
+     [LE] = "<=\n", [GT] = ">\n", [GE] = ">=\n", [PLUS] = "+\n",
+     [MINUS] = "-\n", [TIMES] = "*\n", [OVER] = "/\n", [LPAREN] = "(\n",
+     [RPAREN] = ")\n", [LBRACE] = "[\n", [RBRACE] = "]\n", [LCURLY] = "{\n",
+     [RCURLY] = "}\n", [SEMI] = ";\n", [COMMA] = ",\n" };
+
+#define NTOKENS (sizeof tokenText / sizeof tokenText[0])
+
+static const unsigned char * in; /* the trace */
+static const unsigned char * inEnd;
+
+static char out[OUTBUFSIZE];
+static size_t used = 0;
+
+static void fail(const char * msg)
+{ fprintf(stderr,"trdump: %s\n",msg);
+  exit(1);
+}
+
+/* readAll reads file name whole, setting *len */
+static char * readAll(const char * name, size_t * len)
+{ size_t capacity = 65536, n;
+  FILE * f = fopen(name,"rb");
+  char * text;
+  if (f == NULL) return NULL;
+  text = malloc(capacity);
+  *len = 0;
+  while (text != NULL && (n = fread(text + *len,1,capacity - *len,f)) > 0)
+  { *len += n;
+    if (*len == capacity) text = realloc(text,capacity *= 2);
+  }
+  if (text == NULL) fail("out of memory");
+  if (ferror(f)) fail("read error");
+  fclose(f);
+  return text;
+}
+
+static unsigned long getVarint(void)
+{ unsigned long v = 0;
+  int shift = 0;
+  do
+  { if (in == inEnd || shift > 63) fail("trace is cut short or corrupt");
+    v |= (unsigned long) (*in & 0x7f) << shift;
+    shift += 7;
+  } while (*in++ & 0x80);
+  return v;
+}
+
+static void put(const char * s, size_t n)
+{ memcpy(out + used,s,n);
+  used += n;
+}
+
+/* putLine puts the "\t%d: " that starts a line */
+static void putLine(int line)
+{ char digits[12];
+  int n = 0;
+  unsigned u = line < 0 ? -(unsigned) line : (unsigned) line;
+  do digits[n++] = '0' + u % 10; while ((u /= 10) > 0);
+  if (line < 0) digits[n++] = '-';
+  out[used++] = '\t';
+  while (n > 0) out[used++] = digits[--n];
+  out[used++] = ':';
+  out[used++] = ' ';
+}
+
+int main(int argc, char * argv[])
+{ const unsigned char * lexeme;
+  const char * src = NULL;
+  char * trace, * name;
+  size_t traceLen, srcLen = 0, nameLen;
+  long offset = 0;
+  int mode, line = 0;
+  if (argc != 2 && argc != 3)
+  { fprintf(stderr,"usage: %s <trace> [source]\n",argv[0]);
+    exit(1);
+  }
+  trace = readAll(argv[1],&traceLen);
+  if (trace == NULL) fail("cannot open the trace");
+  in = (const unsigned char *) trace;
+  inEnd = in + traceLen;
+  if (traceLen < 6 || memcmp(in,TRACEMAGIC,4) != 0) fail("not a token trace");
+  if (in[4] != TRACEVERSION) fail("trace of another version");
+  mode = in[5];
+  in += 6;
+  nameLen = getVarint();
+  if (nameLen > (size_t) (inEnd - in)) fail("trace is cut short or corrupt");
+  name = malloc(nameLen + 1);
+  if (name == NULL) fail("out of memory");
+  memcpy(name,in,nameLen);
+  name[nameLen] = '\0';
+  in += nameLen;
+  if (mode == TRACE_SOURCE)
+  { src = readAll(argc == 3 ? argv[2] : name,&srcLen);
+    if (src == NULL) fail("cannot open the source of the trace");
+  }
+  else if (mode != TRACE_INLINE) fail("trace of an unknown mode");
+
+  /* the banner main prints */
+  fputs("\nC-MINUS COMPILATION: ",stdout);
+  fwrite(name,1,nameLen,stdout);
+  putchar('\n');
+  while (in < inEnd)
+  { TokenType token = *in++;
+    unsigned long v = getVarint();
+    line += UNZIGZAG(v);
+    if (used > OUTBUFSIZE - MAXLINE)
+    { fwrite(out,1,used,stdout);
+      used = 0;
+    }
+    putLine(line);
+    if (token >= NTOKENS)
+    { used += sprintf(out + used,"Unknown token: %d\n",token);
+      continue;
+    }
+    put(tokenText[token],strlen(tokenText[token]));
+    if (TRACELEXEME(token))
+    { size_t len;
+      if (mode == TRACE_SOURCE)
+      { v = getVarint();
+        offset += UNZIGZAG(v);
+        len = getVarint();
+        if (offset < 0 || (size_t) offset > srcLen || len > srcLen - offset)
+          fail("lexeme out of the source; wrong source?");
+        lexeme = (const unsigned char *) src + offset;
+      }
+      else
+      { len = getVarint();
+        if (len > (size_t) (inEnd - in)) fail("trace is cut short or corrupt");
+        lexeme = in;
+        in += len;
+      }
+      if (len > MAXTOKENLEN + 1) fail("lexeme too long; corrupt trace?");
+      /* the listing shows the lexeme up to a NUL */
+      while (len > 0 && *lexeme != '\0')
+      { out[used++] = *lexeme++;
+        len--;
+      }
+      out[used++] = '\n';
+    }
+  }
+  fwrite(out,1,used,stdout);
+  return 0;
+}
@@ -16,6 +16,8 @@
 static TreeNode * savedTree; /* stores syntax tree for later return */
 static int yyerror(char * message);
 static int yylex(void); // added 11/2/11 to ensure no conflict with lex
+static TreeNode * appendList(TreeNode * last, TreeNode * t);
+static TreeNode * closeList(TreeNode * last);
 %}
 
 %token IF WHILE RETURN INT VOID
@@ -30,20 +32,11 @@ static int yylex(void); // added 11/2/11 to ensure no conflict with lex
 
 %% /* Grammar for C- */
 
-program             : declaration_list { savedTree = $1; } 
+program             : declaration_list { savedTree = closeList($1); } 
                     ;
 declaration_list    : declaration_list declaration
-                         { 
-                              YYSTYPE t = $1; 
-                              if (t != NULL)
-                                   {
-                                        while (t->sibling != NULL) t = t->sibling;
-                                        t->sibling = $2; 
-                                        $$ = $1; 
-                                   } 
-                              else $$ = $2;
-                         }
-                    | declaration { $$ = $1; }
+                         { $$ = appendList($1, $2); }
+                    | declaration { $$ = appendList(NULL, $1); }
                     ;
 declaration         : var_declaration { $$ = $1; }
                     | fun_declaration { $$ = $1; }
@@ -81,21 +74,12 @@ fun_declaration     : type_specifier identifier LPAREN params RPAREN compound_st
                               $$->child[1] = $6;
                          }
                     ;
-params              : param_list { $$ = $1; }
+params              : param_list { $$ = closeList($1); }
                     | VOID { $$ = newTreeNode(Params); $$->lineno = lineno; $$->flag = TRUE; }
                     ;
 param_list          : param_list COMMA param
-                         {
-                              YYSTYPE t = $1; 
-                              if (t != NULL)
-                              { 
-                                   while (t->sibling != NULL) t = t->sibling;
-                                   t->sibling = $3; 
-                                   $$ = $1; 
-                              } 
-                              else $$ = $3;
-                         }
-                    | param { $$ = $1; }
+                         { $$ = appendList($1, $3); }
+                    | param { $$ = appendList(NULL, $1); }
                     ;
 param               : type_specifier identifier
                          {
@@ -117,34 +101,16 @@ param               : type_specifier identifier
 compound_stmt       : LCURLY local_declarations statement_list RCURLY
                          { 
 						$$ = newTreeNode(CompoundStmt);
-                              $$->child[0] = $2;
-                              $$->child[1] = $3;
+                              $$->child[0] = closeList($2);
+                              $$->child[1] = closeList($3);
                          }
                     ;
 local_declarations  : local_declarations var_declaration
-                         {
-						YYSTYPE t = $1; 
-                              if (t != NULL)
-                                   {
-                                        while (t->sibling != NULL) t = t->sibling;
-                                        t->sibling = $2; 
-                                        $$ = $1; 
-                                   } 
-                              else $$ = $2;
-                         }
+                         { $$ = appendList($1, $2); }
                     | empty { $$ = NULL; }
                     ;
 statement_list      : statement_list statement
-                         { 
-						YYSTYPE t = $1; 
-                              if (t != NULL)
-                                   {
-                                        while (t->sibling != NULL) t = t->sibling;
-                                        t->sibling = $2; 
-                                        $$ = $1; 
-                                   } 
-                              else $$ = $2;
-                         }
+                         { $$ = appendList($1, $2); }
                     | empty { $$ = NULL; }
                     ;
 statement			: selection_stmt { $$ = $1; }
@@ -261,21 +227,12 @@ call                : identifier LPAREN args RPAREN
                          $$->child[0] = $3;
                     }
                     ;
-args                : arg_list { $$ = $1; }
+args                : arg_list { $$ = closeList($1); }
                     | empty { $$ = NULL; }
                     ;
 arg_list            : arg_list COMMA expression
-                         {
-                              YYSTYPE t = $1; 
-                              if (t != NULL)
-                              { 
-                                   while (t->sibling != NULL) t = t->sibling;
-                                   t->sibling = $3; 
-                                   $$ = $1; 
-                              } 
-                              else $$ = $3;
-                         }
-                    | expression { $$ = $1; }
+                         { $$ = appendList($1, $3); }
+                    | expression { $$ = appendList(NULL, $1); }
                     ;
 identifier		: ID
                          {
@@ -311,6 +268,36 @@ int yyerror(char * message)
 static int yylex(void)
 { return getToken(); }
 
+/* A list is built as a ring while it is parsed: its
+ * value is the last node, whose sibling points back
+ * to the first, so appendList adds a node in constant
+ * time instead of walking to the end. appendList
+ * skips a NULL node (an empty statement), and NULL is
+ * the empty list. The rule using the list calls
+ * closeList, which cuts the ring and returns the
+ * first node, leaving the usual sibling chain
+ */
+static TreeNode * appendList(TreeNode * last, TreeNode * t)
+{
+	if (t == NULL) return last;
+	if (last == NULL) t->sibling = t;
+	else
+	{
+		t->sibling = last->sibling;
+		last->sibling = t;
+	}
+	return t;
+}
+
+static TreeNode * closeList(TreeNode * last)
+{
+	TreeNode * first;
+	if (last == NULL) return NULL;
+	first = last->sibling;
+	last->sibling = NULL;
+	return first;
+}
+
 TreeNode * parse(void)
 { 
 	yyparse();
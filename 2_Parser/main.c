@@ -48,15 +48,30 @@ int Error = FALSE;
 int main(int argc, char *argv[])
 {
 	TreeNode *syntaxTree;
-	char pgm[120]; /* source code file name */
+	char *pgm; /* source code file name */
 	if (argc != 2)
 	{
-		fprintf(stderr, "usage: %s <filename>\n", argv[0]);
+		fprintf(stderr, "usage: %s <filename>|-\n", argv[0]);
 		exit(1);
 	}
-	strcpy(pgm, argv[1]);
-	if (strchr(pgm, '.') == NULL) strcat(pgm, ".tny");
-	source = fopen(pgm, "r");
+	if (strcmp(argv[1], "-") == 0)
+	{
+		// Read Program from Standard Input
+		pgm = argv[1];
+		source = stdin;
+	}
+	else
+	{
+		pgm = (char *)malloc(strlen(argv[1]) + 5);
+		if (pgm == NULL)
+		{
+			fprintf(stderr, "Out of memory\n");
+			exit(1);
+		}
+		strcpy(pgm, argv[1]);
+		if (strchr(pgm, '.') == NULL) strcat(pgm, ".tny");
+		source = fopen(pgm, "r");
+	}
 	if (source == NULL)
 	{
 		fprintf(stderr, "File %s not found\n", pgm);
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -55,48 +57,112 @@
 /* Pure parsers.  */
 #define YYPURE 0
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 7 "cminus.y"
+
+#define YYPARSER /* distinguishes Yacc output from other code files */
+
+#include "globals.h"
+#include "util.h"
+#include "scan.h"
+#include "parse.h"
+
+#define YYSTYPE TreeNode *
+static TreeNode * savedTree; /* stores syntax tree for later return */
+static int yyerror(char * message);
+static int yylex(void); // added 11/2/11 to ensure no conflict with lex
+static TreeNode * appendList(TreeNode * last, TreeNode * t);
+static TreeNode * closeList(TreeNode * last);
+
+#line 87 "y.tab.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
+/* Use api.header.include to #include this header
+   instead of duplicating it here.  */
+#ifndef YY_YY_Y_TAB_H_INCLUDED
+# define YY_YY_Y_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
 
-/* Tokens.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     IF = 258,
-     WHILE = 259,
-     RETURN = 260,
-     INT = 261,
-     VOID = 262,
-     RPAREN = 263,
-     ELSE = 264,
-     ID = 265,
-     NUM = 266,
-     EQ = 267,
-     NE = 268,
-     LT = 269,
-     LE = 270,
-     GT = 271,
-     GE = 272,
-     LPAREN = 273,
-     LBRACE = 274,
-     RBRACE = 275,
-     LCURLY = 276,
-     RCURLY = 277,
-     COMMA = 278,
-     SEMI = 279,
-     ERROR = 280,
-     MINUS = 281,
-     PLUS = 282,
-     OVER = 283,
-     TIMES = 284,
-     ASSIGN = 285
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    IF = 258,                      /* IF  */
+    WHILE = 259,                   /* WHILE  */
+    RETURN = 260,                  /* RETURN  */
+    INT = 261,                     /* INT  */
+    VOID = 262,                    /* VOID  */
+    RPAREN = 263,                  /* RPAREN  */
+    ELSE = 264,                    /* ELSE  */
+    ID = 265,                      /* ID  */
+    NUM = 266,                     /* NUM  */
+    EQ = 267,                      /* EQ  */
+    NE = 268,                      /* NE  */
+    LT = 269,                      /* LT  */
+    LE = 270,                      /* LE  */
+    GT = 271,                      /* GT  */
+    GE = 272,                      /* GE  */
+    LPAREN = 273,                  /* LPAREN  */
+    LBRACE = 274,                  /* LBRACE  */
+    RBRACE = 275,                  /* RBRACE  */
+    LCURLY = 276,                  /* LCURLY  */
+    RCURLY = 277,                  /* RCURLY  */
+    COMMA = 278,                   /* COMMA  */
+    SEMI = 279,                    /* SEMI  */
+    ERROR = 280,                   /* ERROR  */
+    PLUS = 281,                    /* PLUS  */
+    MINUS = 282,                   /* MINUS  */
+    TIMES = 283,                   /* TIMES  */
+    OVER = 284,                    /* OVER  */
+    ASSIGN = 285                   /* ASSIGN  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 257
 #define IF 258
 #define WHILE 259
 #define RETURN 260
@@ -120,93 +186,186 @@
 #define COMMA 278
 #define SEMI 279
 #define ERROR 280
-#define MINUS 281
-#define PLUS 282
-#define OVER 283
-#define TIMES 284
+#define PLUS 281
+#define MINUS 282
+#define TIMES 283
+#define OVER 284
 #define ASSIGN 285
 
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+typedef int YYSTYPE;
+# define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
+#endif
 
 
+extern YYSTYPE yylval;
 
-/* Copy the first part of user declarations.  */
-#line 7 "cminus.y"
 
-#define YYPARSER /* distinguishes Yacc output from other code files */
+int yyparse (void);
 
-#include "globals.h"
-#include "util.h"
-#include "scan.h"
-#include "parse.h"
 
-#define YYSTYPE TreeNode *
-static TreeNode * savedTree; /* stores syntax tree for later return */
-static int yyerror(char * message);
-static int yylex(void); // added 11/2/11 to ensure no conflict with lex
+#endif /* !YY_YY_Y_TAB_H_INCLUDED  */
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IF = 3,                         /* IF  */
+  YYSYMBOL_WHILE = 4,                      /* WHILE  */
+  YYSYMBOL_RETURN = 5,                     /* RETURN  */
+  YYSYMBOL_INT = 6,                        /* INT  */
+  YYSYMBOL_VOID = 7,                       /* VOID  */
+  YYSYMBOL_RPAREN = 8,                     /* RPAREN  */
+  YYSYMBOL_ELSE = 9,                       /* ELSE  */
+  YYSYMBOL_ID = 10,                        /* ID  */
+  YYSYMBOL_NUM = 11,                       /* NUM  */
+  YYSYMBOL_EQ = 12,                        /* EQ  */
+  YYSYMBOL_NE = 13,                        /* NE  */
+  YYSYMBOL_LT = 14,                        /* LT  */
+  YYSYMBOL_LE = 15,                        /* LE  */
+  YYSYMBOL_GT = 16,                        /* GT  */
+  YYSYMBOL_GE = 17,                        /* GE  */
+  YYSYMBOL_LPAREN = 18,                    /* LPAREN  */
+  YYSYMBOL_LBRACE = 19,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 20,                    /* RBRACE  */
+  YYSYMBOL_LCURLY = 21,                    /* LCURLY  */
+  YYSYMBOL_RCURLY = 22,                    /* RCURLY  */
+  YYSYMBOL_COMMA = 23,                     /* COMMA  */
+  YYSYMBOL_SEMI = 24,                      /* SEMI  */
+  YYSYMBOL_ERROR = 25,                     /* ERROR  */
+  YYSYMBOL_PLUS = 26,                      /* PLUS  */
+  YYSYMBOL_MINUS = 27,                     /* MINUS  */
+  YYSYMBOL_TIMES = 28,                     /* TIMES  */
+  YYSYMBOL_OVER = 29,                      /* OVER  */
+  YYSYMBOL_ASSIGN = 30,                    /* ASSIGN  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_program = 32,                   /* program  */
+  YYSYMBOL_declaration_list = 33,          /* declaration_list  */
+  YYSYMBOL_declaration = 34,               /* declaration  */
+  YYSYMBOL_var_declaration = 35,           /* var_declaration  */
+  YYSYMBOL_type_specifier = 36,            /* type_specifier  */
+  YYSYMBOL_fun_declaration = 37,           /* fun_declaration  */
+  YYSYMBOL_params = 38,                    /* params  */
+  YYSYMBOL_param_list = 39,                /* param_list  */
+  YYSYMBOL_param = 40,                     /* param  */
+  YYSYMBOL_compound_stmt = 41,             /* compound_stmt  */
+  YYSYMBOL_local_declarations = 42,        /* local_declarations  */
+  YYSYMBOL_statement_list = 43,            /* statement_list  */
+  YYSYMBOL_statement = 44,                 /* statement  */
+  YYSYMBOL_selection_stmt = 45,            /* selection_stmt  */
+  YYSYMBOL_expression_stmt = 46,           /* expression_stmt  */
+  YYSYMBOL_iteration_stmt = 47,            /* iteration_stmt  */
+  YYSYMBOL_return_stmt = 48,               /* return_stmt  */
+  YYSYMBOL_expression = 49,                /* expression  */
+  YYSYMBOL_var = 50,                       /* var  */
+  YYSYMBOL_simple_expression = 51,         /* simple_expression  */
+  YYSYMBOL_relop = 52,                     /* relop  */
+  YYSYMBOL_additive_expression = 53,       /* additive_expression  */
+  YYSYMBOL_addop = 54,                     /* addop  */
+  YYSYMBOL_term = 55,                      /* term  */
+  YYSYMBOL_mulop = 56,                     /* mulop  */
+  YYSYMBOL_factor = 57,                    /* factor  */
+  YYSYMBOL_call = 58,                      /* call  */
+  YYSYMBOL_args = 59,                      /* args  */
+  YYSYMBOL_arg_list = 60,                  /* arg_list  */
+  YYSYMBOL_identifier = 61,                /* identifier  */
+  YYSYMBOL_number = 62,                    /* number  */
+  YYSYMBOL_empty = 63                      /* empty  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef int YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
+#ifdef short
+# undef short
 #endif
 
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-/* Copy the second part of user declarations.  */
-
-
-/* Line 216 of yacc.c.  */
-#line 180 "y.tab.c"
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-typedef signed char yytype_int8;
-#else
-typedef short int yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -214,55 +373,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
 #endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -279,11 +489,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -291,8 +501,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -306,88 +516,89 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  9
 /* YYLAST -- Last index in YYTABLE.  */
@@ -399,18 +610,23 @@ union yyalloc
 #define YYNNTS  33
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  66
-/* YYNRULES -- Number of states.  */
+/* YYNSTATES -- Number of states.  */
 #define YYNSTATES  107
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   285
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -444,142 +660,64 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint8 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_uint8 yyrline[] =
 {
-       0,     0,     3,     5,     8,    10,    12,    14,    18,    25,
-      27,    29,    36,    38,    40,    44,    46,    49,    54,    59,
-      62,    64,    67,    69,    71,    73,    75,    77,    79,    87,
-      93,    96,    98,   104,   107,   111,   115,   117,   119,   124,
-     128,   130,   132,   134,   136,   138,   140,   142,   146,   148,
-     150,   152,   156,   158,   160,   162,   166,   168,   170,   172,
-     177,   179,   181,   185,   187,   189,   191
+       0,    35,    35,    37,    39,    41,    42,    44,    52,    64,
+      65,    67,    77,    78,    80,    82,    84,    92,   101,   108,
+     110,   112,   114,   116,   117,   118,   119,   120,   122,   130,
+     137,   138,   140,   147,   153,   159,   165,   167,   172,   179,
+     186,   188,   189,   190,   191,   192,   193,   195,   202,   203,
+     204,   206,   213,   215,   216,   218,   219,   220,   221,   223,
+     230,   231,   233,   235,   237,   244,   251
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      32,     0,    -1,    33,    -1,    33,    34,    -1,    34,    -1,
-      35,    -1,    37,    -1,    36,    61,    24,    -1,    36,    61,
-      19,    62,    20,    24,    -1,     6,    -1,     7,    -1,    36,
-      61,    18,    38,     8,    41,    -1,    39,    -1,     7,    -1,
-      39,    23,    40,    -1,    40,    -1,    36,    61,    -1,    36,
-      61,    19,    20,    -1,    21,    42,    43,    22,    -1,    42,
-      35,    -1,    63,    -1,    43,    44,    -1,    63,    -1,    45,
-      -1,    46,    -1,    41,    -1,    47,    -1,    48,    -1,     3,
-      18,    49,     8,    44,     9,    44,    -1,     3,    18,    49,
-       8,    44,    -1,    49,    24,    -1,    24,    -1,     4,    18,
-      49,     8,    44,    -1,     5,    24,    -1,     5,    49,    24,
-      -1,    50,    30,    49,    -1,    51,    -1,    61,    -1,    61,
-      19,    49,    20,    -1,    53,    52,    53,    -1,    53,    -1,
-      15,    -1,    14,    -1,    16,    -1,    17,    -1,    12,    -1,
-      13,    -1,    53,    54,    55,    -1,    55,    -1,    27,    -1,
-      26,    -1,    55,    56,    57,    -1,    57,    -1,    29,    -1,
-      28,    -1,    18,    49,     8,    -1,    50,    -1,    58,    -1,
-      62,    -1,    61,    18,    59,     8,    -1,    60,    -1,    63,
-      -1,    60,    23,    49,    -1,    49,    -1,    10,    -1,    11,
-      -1,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,    33,    33,    35,    46,    48,    49,    51,    59,    71,
-      72,    74,    84,    85,    87,    98,   100,   108,   117,   124,
-     135,   137,   148,   150,   151,   152,   153,   154,   156,   163,
-     170,   171,   173,   180,   185,   191,   197,   199,   204,   211,
-     218,   220,   221,   222,   223,   224,   225,   227,   234,   235,
-     236,   238,   245,   247,   248,   250,   251,   252,   253,   255,
-     262,   263,   265,   276,   278,   285,   292
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "IF", "WHILE", "RETURN", "INT", "VOID",
-  "RPAREN", "ELSE", "ID", "NUM", "EQ", "NE", "LT", "LE", "GT", "GE",
-  "LPAREN", "LBRACE", "RBRACE", "LCURLY", "RCURLY", "COMMA", "SEMI",
-  "ERROR", "MINUS", "PLUS", "OVER", "TIMES", "ASSIGN", "$accept",
-  "program", "declaration_list", "declaration", "var_declaration",
-  "type_specifier", "fun_declaration", "params", "param_list", "param",
-  "compound_stmt", "local_declarations", "statement_list", "statement",
-  "selection_stmt", "expression_stmt", "iteration_stmt", "return_stmt",
-  "expression", "var", "simple_expression", "relop", "additive_expression",
-  "addop", "term", "mulop", "factor", "call", "args", "arg_list",
-  "identifier", "number", "empty", 0
+  "\"end of file\"", "error", "\"invalid token\"", "IF", "WHILE",
+  "RETURN", "INT", "VOID", "RPAREN", "ELSE", "ID", "NUM", "EQ", "NE", "LT",
+  "LE", "GT", "GE", "LPAREN", "LBRACE", "RBRACE", "LCURLY", "RCURLY",
+  "COMMA", "SEMI", "ERROR", "PLUS", "MINUS", "TIMES", "OVER", "ASSIGN",
+  "$accept", "program", "declaration_list", "declaration",
+  "var_declaration", "type_specifier", "fun_declaration", "params",
+  "param_list", "param", "compound_stmt", "local_declarations",
+  "statement_list", "statement", "selection_stmt", "expression_stmt",
+  "iteration_stmt", "return_stmt", "expression", "var",
+  "simple_expression", "relop", "additive_expression", "addop", "term",
+  "mulop", "factor", "call", "args", "arg_list", "identifier", "number",
+  "empty", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    31,    32,    33,    33,    34,    34,    35,    35,    36,
-      36,    37,    38,    38,    39,    39,    40,    40,    41,    42,
-      42,    43,    43,    44,    44,    44,    44,    44,    45,    45,
-      46,    46,    47,    48,    48,    49,    49,    50,    50,    51,
-      51,    52,    52,    52,    52,    52,    52,    53,    53,    54,
-      54,    55,    55,    56,    56,    57,    57,    57,    57,    58,
-      59,    59,    60,    60,    61,    62,    63
-};
+#define YYPACT_NINF (-92)
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
-{
-       0,     2,     1,     2,     1,     1,     1,     3,     6,     1,
-       1,     6,     1,     1,     3,     1,     2,     4,     4,     2,
-       1,     2,     1,     1,     1,     1,     1,     1,     7,     5,
-       2,     1,     5,     2,     3,     3,     1,     1,     4,     3,
-       1,     1,     1,     1,     1,     1,     1,     3,     1,     1,
-       1,     3,     1,     1,     1,     3,     1,     1,     1,     4,
-       1,     1,     3,     1,     1,     1,     0
-};
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
-   means the default is an error.  */
-static const yytype_uint8 yydefact[] =
-{
-       0,     9,    10,     0,     2,     4,     5,     0,     6,     1,
-       3,    64,     0,     0,     0,     7,    10,     0,     0,    12,
-      15,    65,     0,    16,     0,     0,     0,     0,    66,    11,
-      14,     8,    17,    66,    20,    19,     0,     0,    22,     0,
-       0,     0,     0,     0,    18,    31,    25,    21,    23,    24,
-      26,    27,     0,    56,    36,    40,    48,    52,    57,    37,
-      58,     0,     0,    33,     0,     0,    30,     0,    45,    46,
-      42,    41,    43,    44,    50,    49,     0,     0,    54,    53,
-       0,    66,     0,     0,     0,    34,    55,    35,    56,    39,
-      47,    51,    63,     0,    60,    61,     0,     0,     0,    59,
-       0,    38,    29,    32,    62,     0,    28
-};
+#define YYTABLE_NINF (-14)
 
-/* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int8 yydefgoto[] =
-{
-      -1,     3,     4,     5,     6,     7,     8,    18,    19,    20,
-      46,    33,    37,    47,    48,    49,    50,    51,    52,    53,
-      54,    76,    55,    77,    56,    80,    57,    58,    93,    94,
-      59,    60,    34
-};
+#define yytable_value_is_error(Yyn) \
+  0
 
 /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
    STATE-NUM.  */
-#define YYPACT_NINF -92
 static const yytype_int8 yypact[] =
 {
       50,   -92,   -92,    11,    50,   -92,   -92,    14,   -92,   -92,
@@ -595,6 +733,24 @@ static const yytype_int8 yypact[] =
       27,   -92,    82,   -92,   -92,    31,   -92
 };
 
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
+{
+       0,     9,    10,     0,     2,     4,     5,     0,     6,     1,
+       3,    64,     0,     0,     0,     7,    10,     0,     0,    12,
+      15,    65,     0,    16,     0,     0,     0,     0,    66,    11,
+      14,     8,    17,    66,    20,    19,     0,     0,    22,     0,
+       0,     0,     0,     0,    18,    31,    25,    21,    23,    24,
+      26,    27,     0,    56,    36,    40,    48,    52,    57,    37,
+      58,     0,     0,    33,     0,     0,    30,     0,    45,    46,
+      42,    41,    43,    44,    49,    50,     0,     0,    53,    54,
+       0,    66,     0,     0,     0,    34,    55,    35,    56,    39,
+      47,    51,    63,     0,    60,    61,     0,     0,     0,    59,
+       0,    38,    29,    32,    62,     0,    28
+};
+
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
@@ -604,11 +760,18 @@ static const yytype_int8 yypgoto[] =
       -4,    84,   -31
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -14
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int8 yydefgoto[] =
+{
+       0,     3,     4,     5,     6,     7,     8,    18,    19,    20,
+      46,    33,    37,    47,    48,    49,    50,    51,    52,    53,
+      54,    76,    55,    77,    56,    80,    57,    58,    93,    94,
+      59,    60,    34
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
       64,    65,    38,    12,    11,    21,   102,   103,    40,    41,
@@ -623,7 +786,7 @@ static const yytype_int8 yytable[] =
      101,   105,    10,    30,    90,    29,    91,    35,    22,    89
 };
 
-static const yytype_uint8 yycheck[] =
+static const yytype_int8 yycheck[] =
 {
       42,    43,    33,     7,    10,    11,    97,    98,     3,     4,
        5,     0,    18,    17,   105,    10,    11,    19,    24,    61,
@@ -637,9 +800,9 @@ static const yytype_uint8 yycheck[] =
       20,     9,     4,    25,    77,    24,    80,    33,    14,    76
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     6,     7,    32,    33,    34,    35,    36,    37,     0,
       34,    10,    61,    18,    19,    24,     7,    36,    38,    39,
@@ -654,95 +817,65 @@ static const yytype_uint8 yystos[] =
       23,    20,    44,    44,    49,     9,    44
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
-
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
-
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
+{
+       0,    31,    32,    33,    33,    34,    34,    35,    35,    36,
+      36,    37,    38,    38,    39,    39,    40,    40,    41,    42,
+      42,    43,    43,    44,    44,    44,    44,    44,    45,    45,
+      46,    46,    47,    48,    48,    49,    49,    50,    50,    51,
+      51,    52,    52,    52,    52,    52,    52,    53,    53,    54,
+      54,    55,    55,    56,    56,    57,    57,    57,    57,    58,
+      59,    59,    60,    60,    61,    62,    63
+};
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     1,     2,     1,     1,     1,     3,     6,     1,
+       1,     6,     1,     1,     3,     1,     2,     4,     4,     2,
+       1,     2,     1,     1,     1,     1,     1,     1,     7,     5,
+       2,     1,     5,     2,     3,     3,     1,     1,     4,     3,
+       1,     1,     1,     1,     1,     1,     1,     3,     1,     1,
+       1,     3,     1,     1,     1,     3,     1,     1,     1,     4,
+       1,     1,     3,     1,     1,     1,     0
+};
 
-#define YYFAIL		goto yyerrlab
 
-#define YYRECOVERING()  (!!yyerrstatus)
+enum { YYENOMEM = -2 };
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+#define YYRECOVERING()  (!!yyerrstatus)
 
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (YYLEX_PARAM)
-#else
-# define YYLEX yylex ()
-#endif
 
 /* Enable debugging if requested.  */
 #if YYDEBUG
@@ -752,80 +885,58 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -833,80 +944,68 @@ yy_symbol_print (yyoutput, yytype, yyvaluep)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
-static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule)
-#else
 static void
-yy_reduce_print (yyvsp, yyrule)
-    YYSTYPE *yyvsp;
-    int yyrule;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       );
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)]);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -921,478 +1020,219 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
-
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
 
-  if (! yyres)
-    return yystrlen (yystr);
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
 
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
-#else
 static void
-yydestruct (yymsg, yytype, yyvaluep)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep)
 {
-  YYUSE (yyvaluep);
-
+  YY_USE (yyvaluep);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-  switch (yytype)
-    {
-
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
-
 
 
-/* The look-ahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
+/* The semantic value of the lookahead symbol.  */
 YYSTYPE yylval;
-
 /* Number of syntax errors so far.  */
 int yynerrs;
 
 
 
+
 /*----------.
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
 yyparse (void)
-#else
-int
-yyparse ()
-
-#endif
-#endif
 {
-  
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
-
-
-
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
-
-  YYSIZE_T yystacksize = YYINITDEPTH;
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1407,30 +1247,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1445,14 +1281,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1465,567 +1301,564 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 33 "cminus.y"
-    { savedTree = (yyvsp[(1) - (1)]); }
-    break;
-
-  case 3:
-#line 36 "cminus.y"
-    { 
-                              YYSTYPE t = (yyvsp[(1) - (2)]); 
-                              if (t != NULL)
-                                   {
-                                        while (t->sibling != NULL) t = t->sibling;
-                                        t->sibling = (yyvsp[(2) - (2)]); 
-                                        (yyval) = (yyvsp[(1) - (2)]); 
-                                   } 
-                              else (yyval) = (yyvsp[(2) - (2)]);
-                         }
+  case 2: /* program: declaration_list  */
+#line 35 "cminus.y"
+                                       { savedTree = closeList(yyvsp[0]); }
+#line 1308 "y.tab.c"
     break;
 
-  case 4:
-#line 46 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 3: /* declaration_list: declaration_list declaration  */
+#line 38 "cminus.y"
+                         { yyval = appendList(yyvsp[-1], yyvsp[0]); }
+#line 1314 "y.tab.c"
     break;
 
-  case 5:
-#line 48 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 4: /* declaration_list: declaration  */
+#line 39 "cminus.y"
+                                  { yyval = appendList(NULL, yyvsp[0]); }
+#line 1320 "y.tab.c"
     break;
 
-  case 6:
-#line 49 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 5: /* declaration: var_declaration  */
+#line 41 "cminus.y"
+                                      { yyval = yyvsp[0]; }
+#line 1326 "y.tab.c"
     break;
 
-  case 7:
-#line 52 "cminus.y"
-    { 
-							(yyval) = newTreeNode(VariableDecl);
-							(yyval)->lineno = (yyvsp[(2) - (3)])->lineno;
-							(yyval)->type = (yyvsp[(1) - (3)])->type;
-							(yyval)->name = (yyvsp[(2) - (3)])->name;
-							free((yyvsp[(1) - (3)])); free((yyvsp[(2) - (3)]));
-                         }
+  case 6: /* declaration: fun_declaration  */
+#line 42 "cminus.y"
+                                      { yyval = yyvsp[0]; }
+#line 1332 "y.tab.c"
     break;
 
-  case 8:
-#line 60 "cminus.y"
-    { 
-							(yyval) = newTreeNode(VariableDecl);
-							(yyval)->lineno = (yyvsp[(2) - (6)])->lineno;
-							if ((yyvsp[(1) - (6)])->type == Integer) (yyval)->type = IntegerArray;
-							else if ((yyvsp[(1) - (6)])->type == Void) (yyval)->type = VoidArray;
-							else (yyval)->type = None;
-							(yyval)->name = (yyvsp[(2) - (6)])->name;
-							(yyval)->child[0] = (yyvsp[(4) - (6)]);
-							free((yyvsp[(1) - (6)])); free((yyvsp[(2) - (6)]));
+  case 7: /* var_declaration: type_specifier identifier SEMI  */
+#line 45 "cminus.y"
+                         { 
+							yyval = newTreeNode(VariableDecl);
+							yyval->lineno = yyvsp[-1]->lineno;
+							yyval->type = yyvsp[-2]->type;
+							yyval->name = yyvsp[-1]->name;
+							free(yyvsp[-2]); free(yyvsp[-1]);
+                         }
+#line 1344 "y.tab.c"
+    break;
+
+  case 8: /* var_declaration: type_specifier identifier LBRACE number RBRACE SEMI  */
+#line 53 "cminus.y"
+                         { 
+							yyval = newTreeNode(VariableDecl);
+							yyval->lineno = yyvsp[-4]->lineno;
+							if (yyvsp[-5]->type == Integer) yyval->type = IntegerArray;
+							else if (yyvsp[-5]->type == Void) yyval->type = VoidArray;
+							else yyval->type = None;
+							yyval->name = yyvsp[-4]->name;
+							yyval->child[0] = yyvsp[-2];
+							free(yyvsp[-5]); free(yyvsp[-4]);
                          }
+#line 1359 "y.tab.c"
     break;
 
-  case 9:
-#line 71 "cminus.y"
-    { (yyval) = newTreeNode(TypeSpecifier); (yyval)->lineno = lineno; (yyval)->type = Integer; }
+  case 9: /* type_specifier: INT  */
+#line 64 "cminus.y"
+                           { yyval = newTreeNode(TypeSpecifier); yyval->lineno = lineno; yyval->type = Integer; }
+#line 1365 "y.tab.c"
     break;
 
-  case 10:
-#line 72 "cminus.y"
-    { (yyval) = newTreeNode(TypeSpecifier); (yyval)->lineno = lineno; (yyval)->type = Void; }
+  case 10: /* type_specifier: VOID  */
+#line 65 "cminus.y"
+                           { yyval = newTreeNode(TypeSpecifier); yyval->lineno = lineno; yyval->type = Void; }
+#line 1371 "y.tab.c"
     break;
 
-  case 11:
-#line 75 "cminus.y"
-    { 
-						(yyval) = newTreeNode(FunctionDecl); 
-                              (yyval)->lineno = lineno; 
-                              (yyval)->type = (yyvsp[(1) - (6)])->type;
-                              (yyval)->name = (yyvsp[(2) - (6)])->name;
-                              (yyval)->child[0] = (yyvsp[(4) - (6)]);
-                              (yyval)->child[1] = (yyvsp[(6) - (6)]);
+  case 11: /* fun_declaration: type_specifier identifier LPAREN params RPAREN compound_stmt  */
+#line 68 "cminus.y"
+                         { 
+						yyval = newTreeNode(FunctionDecl); 
+                              yyval->lineno = lineno; 
+                              yyval->type = yyvsp[-5]->type;
+                              yyval->name = yyvsp[-4]->name;
+                              yyval->child[0] = yyvsp[-2];
+                              yyval->child[1] = yyvsp[0];
                          }
+#line 1384 "y.tab.c"
     break;
 
-  case 12:
-#line 84 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 12: /* params: param_list  */
+#line 77 "cminus.y"
+                                 { yyval = closeList(yyvsp[0]); }
+#line 1390 "y.tab.c"
     break;
 
-  case 13:
-#line 85 "cminus.y"
-    { (yyval) = newTreeNode(Params); (yyval)->lineno = lineno; (yyval)->flag = TRUE; }
+  case 13: /* params: VOID  */
+#line 78 "cminus.y"
+                           { yyval = newTreeNode(Params); yyval->lineno = lineno; yyval->flag = TRUE; }
+#line 1396 "y.tab.c"
     break;
 
-  case 14:
-#line 88 "cminus.y"
-    {
-                              YYSTYPE t = (yyvsp[(1) - (3)]); 
-                              if (t != NULL)
-                              { 
-                                   while (t->sibling != NULL) t = t->sibling;
-                                   t->sibling = (yyvsp[(3) - (3)]); 
-                                   (yyval) = (yyvsp[(1) - (3)]); 
-                              } 
-                              else (yyval) = (yyvsp[(3) - (3)]);
-                         }
+  case 14: /* param_list: param_list COMMA param  */
+#line 81 "cminus.y"
+                         { yyval = appendList(yyvsp[-2], yyvsp[0]); }
+#line 1402 "y.tab.c"
     break;
 
-  case 15:
-#line 98 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 15: /* param_list: param  */
+#line 82 "cminus.y"
+                            { yyval = appendList(NULL, yyvsp[0]); }
+#line 1408 "y.tab.c"
     break;
 
-  case 16:
-#line 101 "cminus.y"
-    {
-						(yyval) = newTreeNode(Params);
-                              (yyval)->type = (yyvsp[(1) - (2)])->type;
-                              (yyval)->name = (yyvsp[(2) - (2)])->name;
-                              (yyval)->lineno = (yyvsp[(2) - (2)])->lineno;
-                              free((yyvsp[(1) - (2)])); free((yyvsp[(2) - (2)]));
+  case 16: /* param: type_specifier identifier  */
+#line 85 "cminus.y"
+                         {
+						yyval = newTreeNode(Params);
+                              yyval->type = yyvsp[-1]->type;
+                              yyval->name = yyvsp[0]->name;
+                              yyval->lineno = yyvsp[0]->lineno;
+                              free(yyvsp[-1]); free(yyvsp[0]);
                          }
+#line 1420 "y.tab.c"
     break;
 
-  case 17:
-#line 109 "cminus.y"
-    { 
-                              (yyval) = newTreeNode(Params);
-                              if((yyvsp[(1) - (4)])->type == Integer) (yyval)->type = IntegerArray;
-                              else if((yyvsp[(1) - (4)])->type == Void) (yyval)->type = VoidArray;
-                              else (yyval)->type = None;
-                              (yyval)->name = (yyvsp[(2) - (4)])->name;
+  case 17: /* param: type_specifier identifier LBRACE RBRACE  */
+#line 93 "cminus.y"
+                         { 
+                              yyval = newTreeNode(Params);
+                              if(yyvsp[-3]->type == Integer) yyval->type = IntegerArray;
+                              else if(yyvsp[-3]->type == Void) yyval->type = VoidArray;
+                              else yyval->type = None;
+                              yyval->name = yyvsp[-2]->name;
                          }
+#line 1432 "y.tab.c"
     break;
 
-  case 18:
-#line 118 "cminus.y"
-    { 
-						(yyval) = newTreeNode(CompoundStmt);
-                              (yyval)->child[0] = (yyvsp[(2) - (4)]);
-                              (yyval)->child[1] = (yyvsp[(3) - (4)]);
+  case 18: /* compound_stmt: LCURLY local_declarations statement_list RCURLY  */
+#line 102 "cminus.y"
+                         { 
+						yyval = newTreeNode(CompoundStmt);
+                              yyval->child[0] = closeList(yyvsp[-2]);
+                              yyval->child[1] = closeList(yyvsp[-1]);
                          }
+#line 1442 "y.tab.c"
     break;
 
-  case 19:
-#line 125 "cminus.y"
-    {
-						YYSTYPE t = (yyvsp[(1) - (2)]); 
-                              if (t != NULL)
-                                   {
-                                        while (t->sibling != NULL) t = t->sibling;
-                                        t->sibling = (yyvsp[(2) - (2)]); 
-                                        (yyval) = (yyvsp[(1) - (2)]); 
-                                   } 
-                              else (yyval) = (yyvsp[(2) - (2)]);
-                         }
+  case 19: /* local_declarations: local_declarations var_declaration  */
+#line 109 "cminus.y"
+                         { yyval = appendList(yyvsp[-1], yyvsp[0]); }
+#line 1448 "y.tab.c"
     break;
 
-  case 20:
-#line 135 "cminus.y"
-    { (yyval) = NULL; }
+  case 20: /* local_declarations: empty  */
+#line 110 "cminus.y"
+                            { yyval = NULL; }
+#line 1454 "y.tab.c"
     break;
 
-  case 21:
-#line 138 "cminus.y"
-    { 
-						YYSTYPE t = (yyvsp[(1) - (2)]); 
-                              if (t != NULL)
-                                   {
-                                        while (t->sibling != NULL) t = t->sibling;
-                                        t->sibling = (yyvsp[(2) - (2)]); 
-                                        (yyval) = (yyvsp[(1) - (2)]); 
-                                   } 
-                              else (yyval) = (yyvsp[(2) - (2)]);
-                         }
+  case 21: /* statement_list: statement_list statement  */
+#line 113 "cminus.y"
+                         { yyval = appendList(yyvsp[-1], yyvsp[0]); }
+#line 1460 "y.tab.c"
     break;
 
-  case 22:
-#line 148 "cminus.y"
-    { (yyval) = NULL; }
+  case 22: /* statement_list: empty  */
+#line 114 "cminus.y"
+                            { yyval = NULL; }
+#line 1466 "y.tab.c"
     break;
 
-  case 23:
-#line 150 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 23: /* statement: selection_stmt  */
+#line 116 "cminus.y"
+                                                 { yyval = yyvsp[0]; }
+#line 1472 "y.tab.c"
     break;
 
-  case 24:
-#line 151 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 24: /* statement: expression_stmt  */
+#line 117 "cminus.y"
+                                      { yyval = yyvsp[0]; }
+#line 1478 "y.tab.c"
     break;
 
-  case 25:
-#line 152 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 25: /* statement: compound_stmt  */
+#line 118 "cminus.y"
+                                    { yyval = yyvsp[0]; }
+#line 1484 "y.tab.c"
     break;
 
-  case 26:
-#line 153 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 26: /* statement: iteration_stmt  */
+#line 119 "cminus.y"
+                                     { yyval = yyvsp[0]; }
+#line 1490 "y.tab.c"
     break;
 
-  case 27:
-#line 154 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 27: /* statement: return_stmt  */
+#line 120 "cminus.y"
+                                  { yyval = yyvsp[0]; }
+#line 1496 "y.tab.c"
     break;
 
-  case 28:
-#line 157 "cminus.y"
-    {
-                              (yyval) = newTreeNode(IfStmt);
-                              (yyval)->child[0] = (yyvsp[(3) - (7)]);
-                              (yyval)->child[1] = (yyvsp[(5) - (7)]);
-                              (yyval)->child[2] = (yyvsp[(7) - (7)]);
+  case 28: /* selection_stmt: IF LPAREN expression RPAREN statement ELSE statement  */
+#line 123 "cminus.y"
+                         {
+                              yyval = newTreeNode(IfStmt);
+                              yyval->child[0] = yyvsp[-4];
+                              yyval->child[1] = yyvsp[-2];
+                              yyval->child[2] = yyvsp[0];
+                              yyval->flag = TRUE;
                          }
+#line 1508 "y.tab.c"
     break;
 
-  case 29:
-#line 164 "cminus.y"
-    {
-                              (yyval) = newTreeNode(IfStmt);
-                              (yyval)->child[0] = (yyvsp[(3) - (5)]);
-                              (yyval)->child[1] = (yyvsp[(5) - (5)]);
+  case 29: /* selection_stmt: IF LPAREN expression RPAREN statement  */
+#line 131 "cminus.y"
+                         {
+                              yyval = newTreeNode(IfStmt);
+                              yyval->child[0] = yyvsp[-2];
+                              yyval->child[1] = yyvsp[0];
                          }
+#line 1518 "y.tab.c"
     break;
 
-  case 30:
-#line 170 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (2)]); }
+  case 30: /* expression_stmt: expression SEMI  */
+#line 137 "cminus.y"
+                                      { yyval = yyvsp[-1]; }
+#line 1524 "y.tab.c"
     break;
 
-  case 31:
-#line 171 "cminus.y"
-    { (yyval) = NULL; }
+  case 31: /* expression_stmt: SEMI  */
+#line 138 "cminus.y"
+                           { yyval = NULL; }
+#line 1530 "y.tab.c"
     break;
 
-  case 32:
-#line 174 "cminus.y"
-    { 
-							(yyval) = newTreeNode(WhileStmt);
-                                   (yyval)->child[0] = (yyvsp[(3) - (5)]);
-                                   (yyval)->child[1] = (yyvsp[(5) - (5)]);
+  case 32: /* iteration_stmt: WHILE LPAREN expression RPAREN statement  */
+#line 141 "cminus.y"
+                         { 
+							yyval = newTreeNode(WhileStmt);
+                                   yyval->child[0] = yyvsp[-2];
+                                   yyval->child[1] = yyvsp[0];
                          }
+#line 1540 "y.tab.c"
     break;
 
-  case 33:
-#line 181 "cminus.y"
-    { 
-                              (yyval) = newTreeNode(ReturnStmt);
-                              (yyval)->child[0] = NULL;
+  case 33: /* return_stmt: RETURN SEMI  */
+#line 148 "cminus.y"
+                         { 
+                              yyval = newTreeNode(ReturnStmt);
+                              yyval->child[0] = NULL;
+                              yyval->flag = TRUE;
                          }
+#line 1550 "y.tab.c"
     break;
 
-  case 34:
-#line 186 "cminus.y"
-    { 
-                              (yyval) = newTreeNode(ReturnStmt);
-                              (yyval)->child[0] = (yyvsp[(2) - (3)]);
+  case 34: /* return_stmt: RETURN expression SEMI  */
+#line 154 "cminus.y"
+                         { 
+                              yyval = newTreeNode(ReturnStmt);
+                              yyval->child[0] = yyvsp[-1];
                          }
+#line 1559 "y.tab.c"
     break;
 
-  case 35:
-#line 192 "cminus.y"
-    { 
-                              (yyval) = newTreeNode(AssignExpr);
-                              (yyval)->child[0] = (yyvsp[(1) - (3)]);
-                              (yyval)->child[1] = (yyvsp[(3) - (3)]);
+  case 35: /* expression: var ASSIGN expression  */
+#line 160 "cminus.y"
+                         { 
+                              yyval = newTreeNode(AssignExpr);
+                              yyval->child[0] = yyvsp[-2];
+                              yyval->child[1] = yyvsp[0];
                          }
+#line 1569 "y.tab.c"
     break;
 
-  case 36:
-#line 197 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 36: /* expression: simple_expression  */
+#line 165 "cminus.y"
+                                        { yyval = yyvsp[0]; }
+#line 1575 "y.tab.c"
     break;
 
-  case 37:
-#line 200 "cminus.y"
-    { 
-						(yyval) = newTreeNode(VarAccessExpr);
-                              (yyval)->name = (yyvsp[(1) - (1)])->name;
+  case 37: /* var: identifier  */
+#line 168 "cminus.y"
+                         { 
+						yyval = newTreeNode(VarAccessExpr);
+                              yyval->name = yyvsp[0]->name;
                          }
+#line 1584 "y.tab.c"
     break;
 
-  case 38:
-#line 205 "cminus.y"
-    {
-						(yyval) = newTreeNode(VarAccessExpr);
-                              (yyval)->name = (yyvsp[(1) - (4)])->name;
-                              (yyval)->child[0] = (yyvsp[(3) - (4)]);
+  case 38: /* var: identifier LBRACE expression RBRACE  */
+#line 173 "cminus.y"
+                         {
+						yyval = newTreeNode(VarAccessExpr);
+                              yyval->name = yyvsp[-3]->name;
+                              yyval->child[0] = yyvsp[-1];
                          }
+#line 1594 "y.tab.c"
     break;
 
-  case 39:
-#line 212 "cminus.y"
-    { 
-						(yyval) = newTreeNode(BinOpExpr);
-                              (yyval)->opcode = (yyvsp[(2) - (3)])->opcode;
-                              (yyval)->child[0] = (yyvsp[(1) - (3)]);
-                              (yyval)->child[1] = (yyvsp[(3) - (3)]);
+  case 39: /* simple_expression: additive_expression relop additive_expression  */
+#line 180 "cminus.y"
+                         { 
+						yyval = newTreeNode(BinOpExpr);
+                              yyval->opcode = yyvsp[-1]->opcode;
+                              yyval->child[0] = yyvsp[-2];
+                              yyval->child[1] = yyvsp[0];
                          }
+#line 1605 "y.tab.c"
     break;
 
-  case 40:
-#line 218 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 40: /* simple_expression: additive_expression  */
+#line 186 "cminus.y"
+                                          { yyval = yyvsp[0]; }
+#line 1611 "y.tab.c"
     break;
 
-  case 41:
-#line 220 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = LE; }
+  case 41: /* relop: LE  */
+#line 188 "cminus.y"
+                         { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = LE; }
+#line 1617 "y.tab.c"
     break;
 
-  case 42:
-#line 221 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = LT; }
+  case 42: /* relop: LT  */
+#line 189 "cminus.y"
+                         { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = LT; }
+#line 1623 "y.tab.c"
     break;
 
-  case 43:
-#line 222 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = GT; }
+  case 43: /* relop: GT  */
+#line 190 "cminus.y"
+                         { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = GT; }
+#line 1629 "y.tab.c"
     break;
 
-  case 44:
-#line 223 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = GE; }
+  case 44: /* relop: GE  */
+#line 191 "cminus.y"
+                         { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = GE; }
+#line 1635 "y.tab.c"
     break;
 
-  case 45:
-#line 224 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = EQ; }
+  case 45: /* relop: EQ  */
+#line 192 "cminus.y"
+                         { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = EQ; }
+#line 1641 "y.tab.c"
     break;
 
-  case 46:
-#line 225 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = NE; }
+  case 46: /* relop: NE  */
+#line 193 "cminus.y"
+                         { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = NE; }
+#line 1647 "y.tab.c"
     break;
 
-  case 47:
-#line 228 "cminus.y"
-    { 
-                              (yyval) = newTreeNode(BinOpExpr);
-                              (yyval)->opcode = (yyvsp[(2) - (3)])->opcode;
-                              (yyval)->child[0] = (yyvsp[(1) - (3)]);
-                              (yyval)->child[1] = (yyvsp[(3) - (3)]);
+  case 47: /* additive_expression: additive_expression addop term  */
+#line 196 "cminus.y"
+                    { 
+                              yyval = newTreeNode(BinOpExpr);
+                              yyval->opcode = yyvsp[-1]->opcode;
+                              yyval->child[0] = yyvsp[-2];
+                              yyval->child[1] = yyvsp[0];
                     }
+#line 1658 "y.tab.c"
     break;
 
-  case 48:
-#line 234 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 48: /* additive_expression: term  */
+#line 202 "cminus.y"
+                           { yyval = yyvsp[0]; }
+#line 1664 "y.tab.c"
     break;
 
-  case 49:
-#line 235 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = PLUS; }
+  case 49: /* addop: PLUS  */
+#line 203 "cminus.y"
+                                { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = PLUS; }
+#line 1670 "y.tab.c"
     break;
 
-  case 50:
-#line 236 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = MINUS; }
+  case 50: /* addop: MINUS  */
+#line 204 "cminus.y"
+                            { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = MINUS; }
+#line 1676 "y.tab.c"
     break;
 
-  case 51:
-#line 239 "cminus.y"
-    {
-                              (yyval) = newTreeNode(BinOpExpr);
-                              (yyval)->opcode = (yyvsp[(2) - (3)])->opcode;
-                              (yyval)->child[0] = (yyvsp[(1) - (3)]);
-                              (yyval)->child[1] = (yyvsp[(3) - (3)]);
+  case 51: /* term: term mulop factor  */
+#line 207 "cminus.y"
+                         {
+                              yyval = newTreeNode(BinOpExpr);
+                              yyval->opcode = yyvsp[-1]->opcode;
+                              yyval->child[0] = yyvsp[-2];
+                              yyval->child[1] = yyvsp[0];
                          }
+#line 1687 "y.tab.c"
     break;
 
-  case 52:
-#line 245 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 52: /* term: factor  */
+#line 213 "cminus.y"
+                             { yyval = yyvsp[0]; }
+#line 1693 "y.tab.c"
     break;
 
-  case 53:
-#line 247 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = TIMES; }
+  case 53: /* mulop: TIMES  */
+#line 215 "cminus.y"
+                            { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = TIMES; }
+#line 1699 "y.tab.c"
     break;
 
-  case 54:
-#line 248 "cminus.y"
-    { (yyval) = newTreeNode(Opcode); (yyval)->lineno = lineno; (yyval)->opcode = OVER; }
+  case 54: /* mulop: OVER  */
+#line 216 "cminus.y"
+                            { yyval = newTreeNode(Opcode); yyval->lineno = lineno; yyval->opcode = OVER; }
+#line 1705 "y.tab.c"
     break;
 
-  case 55:
-#line 250 "cminus.y"
-    { (yyval) = (yyvsp[(2) - (3)]); }
+  case 55: /* factor: LPAREN expression RPAREN  */
+#line 218 "cminus.y"
+                                               { yyval = yyvsp[-1]; }
+#line 1711 "y.tab.c"
     break;
 
-  case 56:
-#line 251 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 56: /* factor: var  */
+#line 219 "cminus.y"
+                          { yyval = yyvsp[0]; }
+#line 1717 "y.tab.c"
     break;
 
-  case 57:
-#line 252 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 57: /* factor: call  */
+#line 220 "cminus.y"
+                           { yyval = yyvsp[0]; }
+#line 1723 "y.tab.c"
     break;
 
-  case 58:
-#line 253 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 58: /* factor: number  */
+#line 221 "cminus.y"
+                             { yyval = yyvsp[0]; }
+#line 1729 "y.tab.c"
     break;
 
-  case 59:
-#line 256 "cminus.y"
-    { 
-                         (yyval) = newTreeNode(CallExpr);
-                         (yyval)->name = (yyvsp[(1) - (4)])->name;
-                         (yyval)->child[0] = (yyvsp[(3) - (4)]);
+  case 59: /* call: identifier LPAREN args RPAREN  */
+#line 224 "cminus.y"
+                    { 
+                         yyval = newTreeNode(CallExpr);
+                         yyval->name = yyvsp[-3]->name;
+                         yyval->child[0] = yyvsp[-1];
                     }
+#line 1739 "y.tab.c"
     break;
 
-  case 60:
-#line 262 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 60: /* args: arg_list  */
+#line 230 "cminus.y"
+                               { yyval = closeList(yyvsp[0]); }
+#line 1745 "y.tab.c"
     break;
 
-  case 61:
-#line 263 "cminus.y"
-    { (yyval) = NULL; }
+  case 61: /* args: empty  */
+#line 231 "cminus.y"
+                            { yyval = NULL; }
+#line 1751 "y.tab.c"
     break;
 
-  case 62:
-#line 266 "cminus.y"
-    {
-                              YYSTYPE t = (yyvsp[(1) - (3)]); 
-                              if (t != NULL)
-                              { 
-                                   while (t->sibling != NULL) t = t->sibling;
-                                   t->sibling = (yyvsp[(3) - (3)]); 
-                                   (yyval) = (yyvsp[(1) - (3)]); 
-                              } 
-                              else (yyval) = (yyvsp[(3) - (3)]);
-                         }
+  case 62: /* arg_list: arg_list COMMA expression  */
+#line 234 "cminus.y"
+                         { yyval = appendList(yyvsp[-2], yyvsp[0]); }
+#line 1757 "y.tab.c"
     break;
 
-  case 63:
-#line 276 "cminus.y"
-    { (yyval) = (yyvsp[(1) - (1)]); }
+  case 63: /* arg_list: expression  */
+#line 235 "cminus.y"
+                                 { yyval = appendList(NULL, yyvsp[0]); }
+#line 1763 "y.tab.c"
     break;
 
-  case 64:
-#line 279 "cminus.y"
-    {
-                              (yyval) = newTreeNode(Indentifier);
-                              (yyval)->lineno = lineno;
-                              (yyval)->name = copyString(tokenString);
+  case 64: /* identifier: ID  */
+#line 238 "cminus.y"
+                         {
+                              yyval = newTreeNode(Indentifier);
+                              yyval->lineno = lineno;
+                              yyval->name = copyString(tokenString);
                          }
+#line 1773 "y.tab.c"
     break;
 
-  case 65:
-#line 286 "cminus.y"
-    {
-                              (yyval) = newTreeNode(ConstExpr);
-                              (yyval)->lineno = lineno;
-                              (yyval)->val = atoi(tokenString);
+  case 65: /* number: NUM  */
+#line 245 "cminus.y"
+                         {
+                              yyval = newTreeNode(ConstExpr);
+                              yyval->lineno = lineno;
+                              yyval->val = atoi(tokenString);
                          }
+#line 1783 "y.tab.c"
     break;
 
-  case 66:
-#line 292 "cminus.y"
-    { (yyval) = NULL;}
+  case 66: /* empty: %empty  */
+#line 251 "cminus.y"
+                      { yyval = NULL;}
+#line 1789 "y.tab.c"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 1936 "y.tab.c"
+#line 1793 "y.tab.c"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (yymsg);
-	  }
-	else
-	  {
-	    yyerror (YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -2034,14 +1867,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2054,42 +1886,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2100,53 +1932,57 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval);
-  /* Do not reclaim the symbols of the rule which action triggered
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-#line 295 "cminus.y"
+#line 254 "cminus.y"
 
 
 int yyerror(char * message)
@@ -2164,9 +2000,38 @@ int yyerror(char * message)
 static int yylex(void)
 { return getToken(); }
 
+/* A list is built as a ring while it is parsed: its
+ * value is the last node, whose sibling points back
+ * to the first, so appendList adds a node in constant
+ * time instead of walking to the end. appendList
+ * skips a NULL node (an empty statement), and NULL is
+ * the empty list. The rule using the list calls
+ * closeList, which cuts the ring and returns the
+ * first node, leaving the usual sibling chain
+ */
+static TreeNode * appendList(TreeNode * last, TreeNode * t)
+{
+	if (t == NULL) return last;
+	if (last == NULL) t->sibling = t;
+	else
+	{
+		t->sibling = last->sibling;
+		last->sibling = t;
+	}
+	return t;
+}
+
+static TreeNode * closeList(TreeNode * last)
+{
+	TreeNode * first;
+	if (last == NULL) return NULL;
+	first = last->sibling;
+	last->sibling = NULL;
+	return first;
+}
+
 TreeNode * parse(void)
 { 
 	yyparse();
 	return savedTree;
 }
-
@@ -8,6 +8,7 @@
 
 #include "analyze.h"
 #include "globals.h"
+#include "intern.h"
 #include "symtab.h"
 #include "util.h"
 
@@ -16,17 +17,17 @@ static ScopeRec *globalScope = NULL;
 static ScopeRec *currentScope = NULL;
 
 // Error Handlers
-static void RedefinitionError(char *name, int lineno, SymbolList symbol)
+static void RedefinitionError(Atom name, int lineno, SymbolList symbol)
 {
 	Error = TRUE;
 	fprintf(listing, "Error: Symbol \"%s\" is redefined at line %d (already defined at line ", name, lineno);
 	int First = TRUE;
 	while (symbol != NULL)
 	{
-		if (strcmp(name, symbol->name) == 0)
+		if (name == symbol->name)
 		{
 			symbol->state = STATE_REDEFINED;
-			if (symbol->node->scope != NULL) symbol->node->scope->state = STATE_REDEFINED;
+			if (symbol->node != NULL && symbol->node->scope != NULL) symbol->node->scope->state = STATE_REDEFINED;
 			if (First != TRUE) fprintf(listing, " ");
 			First = FALSE;
 			fprintf(listing, "%d", symbol->lineList->lineno);
@@ -50,25 +51,25 @@ static SymbolRec *UndeclaredVariableError(ScopeRec *currentScope, TreeNode *node
 	return insertSymbol(currentScope, node->name, Undetermined, VariableSym, node->lineno, NULL);
 }
 
-static void VoidTypeVariableError(char *name, int lineno)
+static void VoidTypeVariableError(Atom name, int lineno)
 {
 	fprintf(listing, "Error: The void-type variable is declared at line %d (name : \"%s\")\n", lineno, name);
 	Error = TRUE;
 }
 
-static void ArrayIndexingError(char *name, int lineno)
+static void ArrayIndexingError(Atom name, int lineno)
 {
 	fprintf(listing, "Error: Invalid array indexing at line %d (name : \"%s\"). indicies should be integer\n", lineno, name);
 	Error = TRUE;
 }
 
-static void ArrayIndexingError2(char *name, int lineno)
+static void ArrayIndexingError2(Atom name, int lineno)
 {
 	fprintf(listing, "Error: Invalid array indexing at line %d (name : \"%s\"). indexing can only allowed for int[] variables\n", lineno, name);
 	Error = TRUE;
 }
 
-static void InvalidFunctionCallError(char *name, int lineno)
+static void InvalidFunctionCallError(Atom name, int lineno)
 {
 	fprintf(listing, "Error: Invalid function call at line %d (name : \"%s\")\n", lineno, name);
 	Error = TRUE;
@@ -99,28 +100,38 @@ static void InvalidConditionError(int lineno)
 }
 
 
-/* Procedure traverse is a generic recursive
- * syntax tree traversal routine:
+// Struct: Traversal
+// The procedures traverse hands to walkTree, through visitPre and visitPost
+typedef struct Traversal
+{
+	void (*preProc)(TreeNode *);
+	void (*postProc)(TreeNode *);
+} Traversal;
+
+static void visitPre(TreeNode *t, void *arg)
+{
+	((Traversal *)arg)->preProc(t);
+}
+
+static void visitPost(TreeNode *t, void *arg)
+{
+	((Traversal *)arg)->postProc(t);
+}
+
+/* Procedure traverse is a generic syntax tree
+ * traversal routine:
  * it applies preProc in preorder and postProc
- * in postorder to tree pointed to by t
+ * in postorder to tree pointed to by t, walking
+ * it with a stack on the heap (walkTree), so
+ * deeply nested code does not overflow the C stack
  */
 static void traverse(TreeNode *t, void (*preProc)(TreeNode *), void (*postProc)(TreeNode *))
 {
-	if (t != NULL)
+	Traversal traversal = {preProc, postProc};
+	if (!walkTree(t, visitPre, visitPost, &traversal))
 	{
-		// pre-order process
-		preProc(t);
-		// traverse childs
-		{
-			int i;
-			for (i = 0; i < MAXCHILDREN; i++) traverse(t->child[i], preProc, postProc);
-		}
-
-		// post-order process
-		postProc(t);
-
-		// traverse siblings
-		traverse(t->sibling, preProc, postProc);
+		fprintf(listing, "Out of memory error at line %d\n", lineno);
+		Error = TRUE;
 	}
 }
 
@@ -242,7 +253,7 @@ void declareBuiltInFunction(void)
 	TreeNode *inputFuncNode = newTreeNode(FunctionDecl);
 	inputFuncNode->lineno = 0;
 	inputFuncNode->type = Integer;
-	inputFuncNode->name = copyString("input");
+	inputFuncNode->name = internString("input");
 	inputFuncNode->child[0] = newTreeNode(Params);
 	inputFuncNode->child[0]->lineno = 0;
 	inputFuncNode->child[0]->type = Void;
@@ -251,11 +262,11 @@ void declareBuiltInFunction(void)
 	TreeNode *outputFuncNode = newTreeNode(FunctionDecl);
 	outputFuncNode->lineno = 0;
 	outputFuncNode->type = Void;
-	outputFuncNode->name = copyString("output");
+	outputFuncNode->name = internString("output");
 	TreeNode *outputFuncParamNode = newTreeNode(Params);
 	outputFuncParamNode->lineno = 0;
 	outputFuncParamNode->type = Integer;
-	outputFuncParamNode->name = copyString("value");
+	outputFuncParamNode->name = internString("value");
 	outputFuncNode->child[0] = outputFuncParamNode;
 
 	insertSymbol(globalScope, inputFuncNode->name, inputFuncNode->type, FunctionSym, inputFuncNode->lineno, inputFuncNode);
@@ -297,6 +308,32 @@ void buildSymtab(TreeNode *syntaxTree)
 	}
 }
 
+void buildSignatures(TreeNode *syntaxTree)
+{
+	// Initialize Global Variables
+	globalScope = insertScope("global", NULL, NULL);
+	currentScope = globalScope;
+
+	declareBuiltInFunction();
+
+	// insert declarations and parameters, never entering a body
+	for (TreeNode *t = syntaxTree; t != NULL; t = t->sibling)
+	{
+		insertNode(t);
+		if (t->kind == FunctionDecl)
+			for (TreeNode *param = t->child[0]; param != NULL; param = param->sibling) insertNode(param);
+		scopeOut(t);
+	}
+
+	fprintf(listing, "\n\n");
+	fprintf(listing, "< Functions >\n");
+	printFunction(listing);
+
+	fprintf(listing, "\n\n");
+	fprintf(listing, "< Global Symbols >\n");
+	printGlobal(listing, globalScope);
+}
+
 static void checkNode(TreeNode *t)
 {
 	switch (t->kind)
@@ -15,6 +15,14 @@
  */
 void buildSymtab(TreeNode *);
 
+/* Procedure buildSignatures constructs the global
+ * scope alone, from the declarations and function
+ * heads, and lists the functions and the global
+ * symbols; function bodies are never entered, so
+ * those a lazy parse left stay unparsed
+ */
+void buildSignatures(TreeNode *);
+
 /* Procedure typeCheck performs type checking
  * by a postorder syntax tree traversal
  */
@@ -0,0 +1,89 @@
+#!/bin/bash
+#
+# Scanner benchmark: the flex scanner (cminus.l) in each table mode
+#
+# usage: ./bench.sh [-s megabytes] [-n runs] [-t modes] [-r revision]
+#
+# Builds a scanner-only cminus_scan_bench (main.c with NO_PARSE) for
+# every flex table mode in modes (default "em f F"; see FLEXTABLES in
+# the Makefile) and, with -r, the same again from cminus.l as of that
+# git revision, to compare against an earlier scanner. The revision
+# must be one whose cminus.l fits the current scan.h (the reentrant
+# ScanContext scanner). Inputs come from ../1_Scanner/mkbench: the
+# default mix and one of comments only. Reports MB/s, best of the runs.
+# Set FLEX or CC to use another flex or compiler.
+
+cd "$(dirname "$0")" || exit 1
+
+size=16
+runs=3
+modes="em f F"
+rev=
+while getopts "s:n:t:r:" opt; do
+    case $opt in
+        s) size=$OPTARG ;;
+        n) runs=$OPTARG ;;
+        t) modes=$OPTARG ;;
+        r) rev=$OPTARG ;;
+        *) echo "usage: $0 [-s megabytes] [-n runs] [-t modes] [-r revision]" >&2; exit 1 ;;
+    esac
+done
+
+flex=${FLEX:-flex}
+if ! command -v "${flex%% *}" > /dev/null 2>&1; then
+    echo "bench: $flex not found" >&2
+    exit 1
+fi
+make -s -C ../1_Scanner mkbench || exit 1
+
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+# build ENGINE MODE [REV]: build $dir/ENGINE in table mode MODE, from
+# the cminus.l of REV if given
+build() {
+    local src="$dir/src-$1"
+    mkdir -p "$src" || return 1
+    cp ./*.c ./*.h ./*.l ./*.y Makefile "$src"/ || return 1
+    if [ -n "$3" ]; then
+        git show "$3:./cminus.l" > "$src/cminus.l" || return 1
+    fi
+    make -s -C "$src" FLEX="$flex" FLEXTABLES="$2" ${CC:+CC="$CC"} cminus_scan_bench > /dev/null || return 1
+    mv "$src/cminus_scan_bench" "$dir/$1"
+}
+
+# best ENGINE FILE: fastest of $runs runs, in nanoseconds
+best() {
+    local t0 t1 t min=
+    for ((i = 0; i < runs; i++)); do
+        t0=$(date +%s%N)
+        "$dir/$1" "$2" > /dev/null || return 1
+        t1=$(date +%s%N)
+        t=$((t1 - t0))
+        if [ -z "$min" ] || [ "$t" -lt "$min" ]; then min=$t; fi
+    done
+    echo "$min"
+}
+
+engines=()
+for m in $modes; do
+    if build "$m" "$m"; then engines+=("$m"); else echo "$m: build failed, skipped"; fi
+    if [ -n "$rev" ]; then
+        if build "$rev:$m" "$m" "$rev"; then engines+=("$rev:$m"); else echo "$rev:$m: build failed, skipped"; fi
+    fi
+done
+
+../1_Scanner/mkbench -s "$size" -r 1 "$dir/mixed.cm" > /dev/null || exit 1
+../1_Scanner/mkbench -s "$size" -r 1 -m comment=1 "$dir/comment.cm" > /dev/null || exit 1
+
+echo
+echo "$size MB inputs, MB/s, best of $runs"
+printf "%-20s %12s %12s\n" engine mixed comment
+for e in "${engines[@]}"; do
+    printf "%-20s" "$e"
+    for f in mixed comment; do
+        ns=$(best "$e" "$dir/$f.cm") || { printf " %12s" failed; continue; }
+        awk -v ns="$ns" -v b="$(stat -c %s "$dir/$f.cm")" 'BEGIN { printf " %12.1f", b / 1048576 / (ns / 1e9) }'
+    done
+    echo
+done
@@ -11,11 +11,69 @@
 #include "util.h"
 #include "scan.h"
 #include "parse.h"
+#include "tokbuf.h"
+#include "intern.h"
+#include "descent.h"
+#include "parallel.h"
+
+#include <limits.h>
+#include <sys/resource.h>
+#include <time.h>
+
+/* set PARSE_STATS to TRUE to report to stderr how
+ * long each parse took, how many nodes it built and
+ * the peak memory of the process so far (as
+ * parsebench.sh does)
+ */
+#ifndef PARSE_STATS
+#define PARSE_STATS FALSE
+#endif
+
+/* the state and value stacks start out in yyparse's
+ * frame and move to the heap, doubling, as they
+ * fill; YYMAXDEPTH leaves memory alone to bound them
+ * instead of bison's 10000 states, so code nested
+ * a million deep parses in linear time and space
+ */
+#define YYMAXDEPTH (INT_MAX / 2)
 
-#define YYSTYPE TreeNode *
-static TreeNode * savedTree; /* stores syntax tree for later return */
-static int yyerror(char * message);
-static int yylex(void); // added 11/2/11 to ensure no conflict with lex
+%}
+
+%define api.pure full
+/* an error right after the local declarations of a
+ * block is one in a local declaration (shift), not
+ * in the statement list that would begin there
+ */
+%expect 1
+%parse-param {struct ParseContext * ctx}
+%lex-param {struct ParseContext * ctx}
+
+/* only the syntax tree is built on the heap: the
+ * values of the token-like nonterminals are plain
+ * (an operator token, a type, or an interned name
+ * with its line), read by the rule using them. The
+ * union is seen in y.tab.h ahead of the types of
+ * globals.h, hence struct treeNode and int
+ */
+%union {
+	struct treeNode * node; /* a syntax tree (or ring list) */
+	int opcode; /* relop, addop, mulop: the operator token */
+	int type; /* type_specifier: Integer or Void (NodeType) */
+	struct { const char * name; int lineno; } id; /* identifier: Atom and line */
+	struct { int start; int end; int values; } body; /* BODY: tokens and first NUM */
+}
+
+%{
+/* the parser is pure: the tree it builds, its error
+ * state and the token it looks at all live in the
+ * ParseContext (parse.h) handed to yyparse, yylex
+ * and yyerror, never in globals
+ */
+static void yyerror(ParseContext * ctx, const char * message);
+static int yylex(YYSTYPE * lvalp, ParseContext * ctx); // added 11/2/11 to ensure no conflict with lex
+static TreeNode * appendList(TreeNode * last, TreeNode * t);
+static TreeNode * closeList(TreeNode * last);
+static int resume(ParseContext * ctx);
 %}
 
 %token IF WHILE RETURN INT VOID
@@ -27,138 +85,186 @@ static int yylex(void); // added 11/2/11 to ensure no conflict with lex
 %left PLUS MINUS 
 %left TIMES OVER 
 %right ASSIGN
+/* BODY stands for a whole function body in a lazy
+ * parse: yylex skips from its LCURLY to the matching
+ * RCURLY, and hands over where its tokens are
+ */
+%token <body> BODY
+/* BODYSTART comes ahead of the tokens of a body
+ * parsed on its own (ParseContext body)
+ */
+%token BODYSTART
+
+%type <node> program declaration_list declaration var_declaration fun_declaration
+%type <node> params param_list param compound_stmt local_declarations statement_list
+%type <node> statement selection_stmt expression_stmt iteration_stmt return_stmt
+%type <node> expression var simple_expression additive_expression term factor
+%type <node> call args arg_list number empty
+%type <opcode> relop addop mulop
+%type <type> type_specifier
+%type <id> identifier
+
+/* trees the parser drops, popped in recovering from
+ * a syntax error or left on its stacks as it gives
+ * up, are freed. A list holds its last node, whose
+ * sibling is the first (appendList), so it is closed
+ * first. The tree of program goes to ctx->tree, so
+ * program itself holds none. A rule giving up with
+ * YYABORT frees its own values, which bison leaves
+ * alone
+ */
+%destructor { freeTree($$); } <node>
+%destructor { freeTree(closeList($$)); } declaration_list param_list local_declarations statement_list arg_list
 
 %% /* Grammar for C- */
 
-program             : declaration_list { savedTree = $1; } 
+/* syntax errors are recovered from at the error
+ * rules of declaration, local_declarations,
+ * statement and compound_stmt:
+ * yacc pops back to where the innermost of them
+ * began and skips tokens, the one in error first, up
+ * to the SEMI or RCURLY ending the rule (see resume)
+ */
+program             : declaration_list { ctx->tree = closeList($1); $$ = NULL; }
+                    | BODYSTART compound_stmt { ctx->tree = $2; $$ = NULL; }
                     ;
 declaration_list    : declaration_list declaration
-                         { 
-							YYSTYPE t = $1; 
-							if (t != NULL)
-                            {
-								while (t->sibling != NULL) t = t->sibling;
-								t->sibling = $2; 
-								$$ = $1; 
-							} 
-							else $$ = $2;
-                         }
-                    | declaration { $$ = $1; }
+                         { $$ = appendList($1, $2); }
+                    | declaration { $$ = appendList(NULL, $1); }
                     ;
 declaration         : var_declaration { $$ = $1; }
                     | fun_declaration { $$ = $1; }
+                    | error SEMI
+                         {
+							$$ = NULL;
+							if (ctx->body || !resume(ctx)) YYABORT;
+							yyerrok;
+                         }
+                    | error RCURLY
+                         {
+							$$ = NULL;
+							if (ctx->body || !resume(ctx)) YYABORT;
+							yyerrok;
+                         }
                     ;
 var_declaration     : type_specifier identifier SEMI
                          { 
 							$$ = newTreeNode(VariableDecl);
-							$$->lineno = $2->lineno;
-							$$->type = $1->type;
-							$$->name = $2->name;
-							free($1); free($2);
+							$$->lineno = $2.lineno;
+							$$->type = $1;
+							$$->name = $2.name;
                          }
                     | type_specifier identifier LBRACE number RBRACE SEMI
                          { 
 							$$ = newTreeNode(VariableDecl);
-							$$->lineno = $2->lineno;
-							if ($1->type == Integer) $$->type = IntegerArray;
-							else if ($1->type == Void) $$->type = VoidArray;
+							$$->lineno = $2.lineno;
+							if ($1 == Integer) $$->type = IntegerArray;
+							else if ($1 == Void) $$->type = VoidArray;
 							else $$->type = None;
-							$$->name = $2->name;
+							$$->name = $2.name;
 							$$->child[0] = $4;
-							free($1); free($2);
                          }
                     ;
-type_specifier      : INT  { $$ = newTreeNode(TypeSpecifier); $$->lineno = lineno; $$->type = Integer; }
-                    | VOID { $$ = newTreeNode(TypeSpecifier); $$->lineno = lineno; $$->type = Void; }
+type_specifier      : INT  { $$ = Integer; }
+                    | VOID { $$ = Void; }
                     ;
 fun_declaration     : type_specifier identifier LPAREN params RPAREN compound_stmt
                          { 
 							$$ = newTreeNode(FunctionDecl);
-							$$->lineno = $2->lineno;
-							$$->type = $1->type;
-							$$->name = $2->name;
+							$$->lineno = $2.lineno;
+							$$->type = $1;
+							$$->name = $2.name;
 							$$->child[0] = $4;
 							$$->child[1] = $6; 
 							$6->flag = TRUE;
-							free($1); free($2);
+                         }
+                    | type_specifier identifier LPAREN params RPAREN BODY
+                         { 
+							$$ = newTreeNode(FunctionDecl);
+							$$->lineno = $2.lineno;
+							$$->type = $1;
+							$$->name = $2.name;
+							$$->child[0] = $4;
+							$$->body = newTokenRange(ctx->tokens, $6.start, $6.end, $6.values);
+							if ($$->body == NULL)
+							{
+								freeTree($$);
+								yyerror(ctx, "out of memory");
+								YYABORT;
+							}
                          }
                     ;
-params              : param_list { $$ = $1; }
+params              : param_list { $$ = closeList($1); }
                     | VOID
                          {
 							$$ = newTreeNode(Params);
-							$$->lineno = lineno;
+							$$->lineno = ctx->lineno;
 							$$->type = Void;
 							$$->flag = TRUE;
                          }
                     ;
 param_list          : param_list COMMA param
-                         {
-							YYSTYPE t = $1; 
-							if (t != NULL) 
-							{ 
-								while (t->sibling != NULL) t = t->sibling;
-								t->sibling = $3;
-								$$ = $1; 
-							} 
-							else $$ = $3;
-                         }
-                    | param { $$ = $1; }
+                         { $$ = appendList($1, $3); }
+                    | param { $$ = appendList(NULL, $1); }
                     ;
 param               : type_specifier identifier
                          {
 							$$ = newTreeNode(Params); 
-							$$->lineno = $2->lineno;
-							$$->type = $1->type;
-							$$->name = $2->name;
+							$$->lineno = $2.lineno;
+							$$->type = $1;
+							$$->name = $2.name;
 							$$->flag = FALSE;
-							free($1); free($2);
                          }
                     | type_specifier identifier LBRACE RBRACE
                          { 
 							$$ = newTreeNode(Params);
-							$$->lineno = $2->lineno;
-							if ($1->type == Integer) $$->type = IntegerArray;
-							else if ($1->type == Void) $$->type = VoidArray;
+							$$->lineno = $2.lineno;
+							if ($1 == Integer) $$->type = IntegerArray;
+							else if ($1 == Void) $$->type = VoidArray;
 							else $$->type = None;
-							$$->name = $2->name;
+							$$->name = $2.name;
 							$$->flag = FALSE;
-							free($1); free($2);
                          }
                     ;
 compound_stmt       : LCURLY local_declarations statement_list RCURLY
                          { 
 							$$ = newTreeNode(CompoundStmt);
-							$$->lineno = lineno;
+							$$->lineno = ctx->lineno;
 							$$->flag = FALSE;
-							$$->child[0] = $2;
-							$$->child[1] = $3;
+							$$->child[0] = closeList($2);
+							$$->child[1] = closeList($3);
+                         }
+                    | LCURLY local_declarations statement_list error RCURLY
+                         { 
+							$$ = newTreeNode(CompoundStmt);
+							$$->lineno = ctx->lineno;
+							$$->flag = FALSE;
+							$$->child[0] = closeList($2);
+							$$->child[1] = closeList($3);
+							if (!resume(ctx))
+							{
+								freeTree($$);
+								YYABORT;
+							}
+							yyerrok;
                          }
                     ;
 local_declarations  : local_declarations var_declaration
+                         { $$ = appendList($1, $2); }
+                    | local_declarations error SEMI
                          {
-							YYSTYPE t = $1; 
-							if (t != NULL)
-							{ 
-								while (t->sibling != NULL) t = t->sibling;
-								t->sibling = $2; 
-								$$ = $1; 
-							} 
-							else $$ = $2;
+							$$ = $1;
+							if (!resume(ctx))
+							{
+								freeTree(closeList($1));
+								YYABORT;
+							}
+							yyerrok;
                          }
                     | empty { $$ = $1; }
                     ;
 statement_list      : statement_list statement
-                         { 
-							YYSTYPE t = $1; 
-							if (t != NULL)
-							{ 
-								while (t->sibling != NULL) t = t->sibling;
-								t->sibling = $2; 
-								$$ = $1; 
-							} 
-							else $$ = $2;
-                         }
+                         { $$ = appendList($1, $2); }
                     | empty { $$ = $1; }
                     ;
 statement			: selection_stmt { $$ = $1; }
@@ -166,6 +272,12 @@ statement			: selection_stmt { $$ = $1; }
                     | compound_stmt { $$ = $1; }
                     | iteration_stmt { $$ = $1; }
                     | return_stmt { $$ = $1; }
+                    | error SEMI
+                         {
+							$$ = NULL;
+							if (!resume(ctx)) YYABORT;
+							yyerrok;
+                         }
 					;
 selection_stmt		: IF LPAREN expression RPAREN statement ELSE statement
 						{
@@ -191,7 +303,7 @@ expression_stmt     : expression SEMI { $$ = $1;}
 iteration_stmt      : WHILE LPAREN expression RPAREN statement
                          { 
 							$$ = newTreeNode(WhileStmt);
-							$$->lineno = lineno;
+							$$->lineno = ctx->lineno;
 							$$->child[0] = $3;
 							$$->child[1] = $5;
                          }
@@ -199,13 +311,13 @@ iteration_stmt      : WHILE LPAREN expression RPAREN statement
 return_stmt         : RETURN SEMI 
 						{ 
 							$$ = newTreeNode(ReturnStmt); 
-							$$->lineno = lineno; 
+							$$->lineno = ctx->lineno; 
 							$$->flag = TRUE;
 						}
                     | RETURN expression SEMI
                          { 
 							$$ = newTreeNode(ReturnStmt);
-							$$->lineno = lineno;
+							$$->lineno = ctx->lineno;
 							$$->flag = FALSE;
 							$$->child[0] = $2;
                          }
@@ -222,63 +334,58 @@ expression          : var ASSIGN expression
 var                 : identifier
                          { 
 							$$ = newTreeNode(VarAccessExpr);
-							$$->lineno = $1->lineno;
-							$$->name = $1->name;
-							free($1);
+							$$->lineno = $1.lineno;
+							$$->name = $1.name;
                          }
                     | identifier LBRACE expression RBRACE
                          {
 							$$ = newTreeNode(VarAccessExpr);
-							$$->lineno = $1->lineno;
-							$$->name = $1->name;
+							$$->lineno = $1.lineno;
+							$$->name = $1.name;
 							$$->child[0] = $3;
-							free($1);
                          }
                     ;
 simple_expression   : additive_expression relop additive_expression
                          { 
 							$$ = newTreeNode(BinOpExpr); 
 							$$->lineno = $1->lineno;
-							$$->opcode = $2->opcode;
+							$$->opcode = $2;
 							$$->child[0] = $1;
 							$$->child[1] = $3;
-							free($2);
                          }
                     | additive_expression { $$ = $1; }
                     ;
-relop               : LE { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = LE; }
-                    | LT { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = LT; }
-                    | GT { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = GT; }
-                    | GE { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = GE; }
-                    | EQ { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = EQ; }
-                    | NE { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = NE; }
+relop               : LE { $$ = LE; }
+                    | LT { $$ = LT; }
+                    | GT { $$ = GT; }
+                    | GE { $$ = GE; }
+                    | EQ { $$ = EQ; }
+                    | NE { $$ = NE; }
                     ;
 additive_expression : additive_expression addop term
                          { 
 							$$ = newTreeNode(BinOpExpr);
 							$$->lineno = $1->lineno;
-							$$->opcode = $2->opcode;
+							$$->opcode = $2;
 							$$->child[0] = $1;
 							$$->child[1] = $3;
-							free($2);
                          }
 					| term { $$ = $1; }
-addop				: PLUS  { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = PLUS; }
-					| MINUS { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = MINUS; }
+addop				: PLUS  { $$ = PLUS; }
+					| MINUS { $$ = MINUS; }
 					;
 term                : term mulop factor
 						{
 							$$ = newTreeNode(BinOpExpr);
 							$$->lineno = $1->lineno;
-							$$->opcode = $2->opcode;
+							$$->opcode = $2;
 							$$->child[0] = $1;
 							$$->child[1] = $3;
-							free($2);
 						}
 					| factor { $$ = $1; }
 					;
-mulop               : TIMES { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = TIMES; }
-					| OVER  { $$ = newTreeNode(Opcode); $$->lineno = lineno; $$->opcode = OVER; }
+mulop               : TIMES { $$ = TIMES; }
+					| OVER  { $$ = OVER; }
 					;
 factor              : LPAREN expression RPAREN { $$ = $2; }
                     | var { $$ = $1; }
@@ -288,40 +395,34 @@ factor              : LPAREN expression RPAREN { $$ = $2; }
 call                : identifier LPAREN args RPAREN
                          { 
 							$$ = newTreeNode(CallExpr);
-							$$->lineno = $1->lineno;
-							$$->name = $1->name;
+							$$->lineno = $1.lineno;
+							$$->name = $1.name;
 							$$->child[0] = $3;
-							free($1);
                          }
                     ;
-args                : arg_list { $$ = $1; }
+args                : arg_list { $$ = closeList($1); }
                     | empty { $$ = $1; }
                     ;
 arg_list            : arg_list COMMA expression
-                         {
-							YYSTYPE t = $1; 
-							if (t != NULL)
-							{ 
-								while (t->sibling != NULL) t = t->sibling;
-								t->sibling = $3; 
-								$$ = $1; 
-							} 
-							else $$ = $3;
-                         }
-                    | expression { $$ = $1; }
+                         { $$ = appendList($1, $3); }
+                    | expression { $$ = appendList(NULL, $1); }
                     ;
 identifier			: ID
 						{
-							$$ = newTreeNode(Indentifier);
-							$$->lineno = lineno;
-							$$->name = copyString(tokenString);
+							$$.name = internName(ctx->tokenString, ctx->tokenLength);
+							$$.lineno = ctx->lineno;
+							if ($$.name == NULL)
+							{
+								yyerror(ctx, "out of memory");
+								YYABORT;
+							}
 						}
 					;
 number				: NUM
 						{
 							$$ = newTreeNode(ConstExpr);
-							$$->lineno = lineno;
-							$$->val = atoi(tokenString);
+							$$->lineno = ctx->lineno;
+							$$->val = ctx->tokenValue;
 						}
 					;
 empty               : { $$ = NULL;}
@@ -329,23 +430,306 @@ empty               : { $$ = NULL;}
 
 %%
 
-int yyerror(char * message)
+static void yyerror(ParseContext * ctx, const char * message)
 {
-	fprintf(listing,"Syntax error at line %d: %s\n",lineno,message);
-	fprintf(listing,"Current token: ");
-	printToken(yychar,tokenString);
-	Error = TRUE;
-	return 0;
+	ctx->error = TRUE;
+	if (++ctx->errors <= ctx->silent || ctx->listing == NULL) return;
+	fprintf(ctx->listing,"Syntax error at line %d: %s\n",ctx->lineno,message);
+	fprintf(ctx->listing,"Current token: ");
+	fprintToken(ctx->listing,ctx->token,ctx->tokenString,ctx->tokenLength);
 }
 
 /* yylex calls getToken to make Yacc/Bison output
- * compatible with ealier versions of the TINY scanner
+ * compatible with ealier versions of the TINY scanner;
+ * the token goes into ctx, where the actions and
+ * yyerror look for it (yychar is yyparse's own).
+ * In a lazy parse an LCURLY with a matching RCURLY
+ * is handed over as one BODY token, ctx keeping the
+ * LCURLY; the grammar only takes one after the
+ * RPAREN of a function head, so any other is a
+ * syntax error, as that LCURLY would be
  */
-static int yylex(void)
-{ return getToken(); }
+static int yylex(YYSTYPE * lvalp, ParseContext * ctx)
+{
+	TokenType token;
+	if (ctx->tokens != NULL)
+	{
+		TokenBuffer * tokens = ctx->tokens;
+		int open = tokens->pos, close, values;
+		if (ctx->body && open == 0 && ctx->token != BODYSTART)
+		{
+			ctx->token = BODYSTART;
+			return BODYSTART;
+		}
+		token = nextToken(tokens);
+		ctx->tokenString = tokens->tokenString;
+		ctx->tokenLength = tokens->tokenLength;
+		ctx->tokenValue = tokens->tokenValue;
+		ctx->lineno = tokens->tokenLine;
+		if (token == LCURLY && LazyParse && !ctx->body && !ctx->unmatched)
+		{
+			close = matchBrace(tokens, open, &values);
+			ctx->unmatched = close < 0;
+		}
+		else
+			close = -1;
+		if (close >= 0)
+		{
+			lvalp->body.start = open;
+			lvalp->body.end = close + 1;
+			lvalp->body.values = tokens->valuePos;
+			tokens->pos = close + 1;
+			tokens->valuePos += values;
+			ctx->token = token;
+			return BODY;
+		}
+	}
+	else
+	{
+		ScanContext * scanner = ctx->scanner;
+		token = getToken(scanner);
+		ctx->tokenString = scanner->tokenString;
+		ctx->tokenLength = scanner->tokenLength;
+		ctx->tokenValue = scanner->tokenValue;
+		ctx->lineno = tokenLine(scanner);
+	}
+	ctx->token = token;
+	return token;
+}
+
+/* A list is built as a ring while it is parsed: its
+ * value is the last node, whose sibling points back
+ * to the first, so appendList adds a node in constant
+ * time instead of walking to the end. appendList
+ * skips a NULL node (an empty statement), and NULL is
+ * the empty list. The rule using the list calls
+ * closeList, which cuts the ring and returns the
+ * first node, leaving the usual sibling chain
+ */
+static TreeNode * appendList(TreeNode * last, TreeNode * t)
+{
+	if (t == NULL) return last;
+	if (last == NULL) t->sibling = t;
+	else
+	{
+		t->sibling = last->sibling;
+		last->sibling = t;
+	}
+	return t;
+}
+
+static TreeNode * closeList(TreeNode * last)
+{
+	TreeNode * first;
+	if (last == NULL) return NULL;
+	first = last->sibling;
+	last->sibling = NULL;
+	return first;
+}
+
+/* resume is called as an error rule is reduced, the
+ * tokens in error skipped: the rule's action goes on
+ * with the parse, reporting the next error at once
+ * (yyerrok), unless MAXSYNTAXERRORS have been met,
+ * which is reported too. The declaration rules give
+ * up in a body parsed on its own too: an error
+ * outside its statements leaves no declaration to go
+ * on with
+ */
+static int resume(ParseContext * ctx)
+{
+	if (ctx->errors < MAXSYNTAXERRORS) return TRUE;
+	if (ctx->listing != NULL)
+		fprintf(ctx->listing,"Too many syntax errors at line %d: parse stopped\n",ctx->lineno);
+	return FALSE;
+}
+
+/* countNodes counts the nodes of a syntax tree */
+static void countNode(TreeNode * t, void * count)
+{
+	(void) t;
+	++*(long *) count;
+}
+
+static long countNodes(TreeNode * t)
+{
+	long n = 0;
+	walkTree(t, countNode, NULL, &n);
+	return n;
+}
+
+TreeNode * parseInput(ParseContext * ctx)
+{
+	ctx->tree = NULL;
+	if (DescentParse && ctx->tokens != NULL)
+	{
+		ctx->tree = ctx->body ? descentParseBody(ctx) : descentParse(ctx);
+		if (!ctx->deep) return ctx->tree;
+		// Start Over, Not Writing Again the Errors Written So Far
+		freeTree(ctx->tree);
+		ctx->tree = NULL;
+		ctx->deep = FALSE;
+		ctx->unmatched = FALSE;
+		ctx->silent = ctx->errors;
+		ctx->errors = 0;
+	}
+	yyparse(ctx);
+	return ctx->tree;
+}
+
+/* runParser parses the tokens or the scanner that
+ * parseFile or parseText set up in ctx, and releases
+ * them; the tokens are parsed on several threads
+ * (parallel.h) when ParallelParse is set
+ */
+static TreeNode * runParser(ParseContext * ctx)
+{
+	ctx->tree = NULL;
+	if (ctx->tokens == NULL && ctx->scanner == NULL)
+	{
+		fprintf(ctx->listing, "Out of memory error at line %d\n", ctx->lineno);
+		ctx->error = TRUE;
+		return NULL;
+	}
+	int parallel = ParallelParse && !LazyParse && ctx->tokens != NULL;
+	struct timespec t0, t1;
+	if (PARSE_STATS) clock_gettime(CLOCK_MONOTONIC, &t0);
+	if (parallel) parallelParse(ctx);
+	else parseInput(ctx);
+	if (PARSE_STATS)
+	{
+		struct rusage usage;
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		getrusage(RUSAGE_SELF, &usage);
+		fprintf(stderr, "parsed %ld nodes in %.3f ms (%s%s%s), peak %ld KB\n", countNodes(ctx->tree),
+				(t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6,
+				DescentParse && ctx->tokens != NULL ? "descent" : "yacc", parallel ? ", parallel" : "",
+				LazyParse && ctx->tokens != NULL ? ", lazy" : "", usage.ru_maxrss);
+	}
+	freeTokenBuffer(ctx->tokens);
+	freeScanner(ctx->scanner);
+	ctx->tokens = NULL;
+	ctx->scanner = NULL;
+	return ctx->tree;
+}
+
+void initParse(ParseContext * ctx, FILE * listing)
+{
+	ctx->tokens = NULL;
+	ctx->scanner = NULL;
+	ctx->body = FALSE;
+	ctx->unmatched = FALSE;
+	ctx->token = 0; /* ENDFILE */
+	ctx->tokenString = "";
+	ctx->tokenLength = 0;
+	ctx->tokenValue = 0;
+	ctx->lineno = 0;
+	ctx->listing = listing;
+	ctx->error = FALSE;
+	ctx->errors = 0;
+	ctx->silent = 0;
+	ctx->deep = FALSE;
+	ctx->tree = NULL;
+}
+
+/* Function lexFailed ends a parse whose tokens could
+ * not be lexed, a failure lexTokenBuffer and
+ * lexTokenText report themselves
+ */
+static TreeNode * lexFailed(ParseContext * ctx)
+{
+	ctx->error = TRUE;
+	ctx->tree = NULL;
+	return NULL;
+}
+
+TreeNode * parseFile(ParseContext * ctx, FILE * file)
+{
+	if (BufferTokens || DescentParse || ParallelParse || LazyParse)
+	{
+		/* the file is read by then, so the scanner
+		 * would find nothing left of it
+		 */
+		ctx->tokens = lexTokenBuffer(file);
+		if (ctx->tokens == NULL) return lexFailed(ctx);
+	}
+	else ctx->scanner = newScanner(file);
+	return runParser(ctx);
+}
+
+TreeNode * parseText(ParseContext * ctx, char * text, size_t size)
+{
+	if (BufferTokens || DescentParse || ParallelParse || LazyParse)
+	{
+		ctx->tokens = lexTokenText(text, size);
+		if (ctx->tokens == NULL) return lexFailed(ctx);
+	}
+	else ctx->scanner = newBufferScanner(text, size);
+	return runParser(ctx);
+}
+
+/* parse and parseBuffer parse with a context of
+ * their own, and hand its error state and line on
+ * to the globals Error and lineno the passes after
+ * them read
+ */
+static TreeNode * parseGlobal(char * text, size_t size)
+{
+	ParseContext ctx;
+	initParse(&ctx, listing);
+	if (text != NULL) parseText(&ctx, text, size);
+	else parseFile(&ctx, source);
+	if (ctx.error) Error = TRUE;
+	lineno = ctx.lineno;
+	return ctx.tree;
+}
+
+TreeNode * functionBody(TreeNode * fn, FILE * listing, int * error)
+{
+	TokenRange * range = fn->body;
+	TokenBuffer view;
+	if (range == NULL) return fn->child[1];
+	fn->body = NULL;
+	if (!viewTokens(range->tokens, range->start, range->end, range->valueStart, &view))
+	{
+		if (listing != NULL) fprintf(listing, "Out of memory error at line %d\n", fn->lineno);
+		*error = TRUE;
+		freeTokenRange(range);
+		return NULL;
+	}
+	ParseContext ctx;
+	initParse(&ctx, listing);
+	ctx.tokens = &view;
+	ctx.body = TRUE;
+	TreeNode * t = parseInput(&ctx);
+	if (ctx.error)
+	{
+		// Not Analyzed, as a Program with a Syntax Error Is Not
+		*error = TRUE;
+		freeTree(t);
+		t = NULL;
+	}
+	if (t != NULL) t->flag = TRUE;
+	fn->child[1] = t;
+	freeTokenView(&view);
+	freeTokenRange(range);
+	return t;
+}
+
+int parseBodies(TreeNode * tree, FILE * listing)
+{
+	int error = FALSE;
+	for (TreeNode * t = tree; t != NULL; t = t->sibling)
+		if (t->body != NULL) functionBody(t, listing, &error);
+	return !error;
+}
 
 TreeNode * parse(void)
 { 
-	yyparse();
-	return savedTree;
+	return parseGlobal(NULL, 0);
+}
+
+TreeNode * parseBuffer(char * text, size_t size)
+{
+	return parseGlobal(text, size);
 }
@@ -0,0 +1,784 @@
+/****************************************************/
+/* File: descent.c                                  */
+/* Recursive descent parser implementation for the  */
+/* C-MINUS compiler                                 */
+/****************************************************/
+
+#include "descent.h"
+
+#include "intern.h"
+#include "scan.h"
+#include "util.h"
+
+/* RELPREC = binding power of the relational operators,
+ * the loosest of the binary operators; they do not
+ * associate, so a < b < c is a syntax error
+ */
+#define RELPREC 1
+
+//-----------------
+// Parser State
+//-----------------
+// Struct: Parser
+// seen is the furthest token looked at so far. The yacc parser reads
+// exactly as far, so the line of that token is the lineno its actions
+// would see, which a few nodes take as their line. error is TRUE from
+// a syntax error up to where the parse recovers from it; stop keeps it
+// so to the end, when the parse gives up.
+typedef struct Parser
+{
+	ParseContext *ctx;
+	TokenBuffer *tokens;
+	int pos;
+	int seen;
+	// Index into value[] of the Next NUM
+	int valuePos;
+	int depth;
+	int error;
+	int stop;
+} Parser;
+
+// Struct: Recovery
+// Where the tokens skipped after a syntax error end, as in the yacc
+// error rules: at a SEMI, skipped too, and for a statement in a
+// statement list at an RCURLY, left to close the list's block, or
+// for a declaration at an RCURLY, skipped too.
+typedef enum Recovery
+{
+	RECOVER_SEMI,
+	RECOVER_BLOCK_END,
+	RECOVER_DECLARATION_END
+} Recovery;
+
+//--------------
+// Token Access
+//--------------
+static TokenType peek(Parser *p)
+{
+	if (p->pos > p->seen) p->seen = p->pos;
+	return KIND2TOKEN(p->tokens->kind[p->pos]);
+}
+
+// Step Past the Current Token, Staying on ENDFILE Once Reached
+static void advance(Parser *p)
+{
+	if (p->pos < p->tokens->count - 1) p->pos++;
+}
+
+static int lineAt(Parser *p, int i)
+{
+	return LINEOF(&p->tokens->lines, p->tokens->offset[i]);
+}
+
+// Report a Syntax Error at the Current Token, as yyerror Does
+static void syntaxError(Parser *p, const char *message)
+{
+	ParseContext *ctx = p->ctx;
+	int i = p->pos;
+	if (p->error) return;
+	p->error = TRUE;
+	ctx->error = TRUE;
+	ctx->errors++;
+	ctx->token = KIND2TOKEN(p->tokens->kind[i]);
+	ctx->tokenString = p->tokens->text + p->tokens->offset[i];
+	ctx->tokenLength = p->tokens->length[i];
+	ctx->lineno = lineAt(p, i);
+	if (ctx->listing == NULL) return;
+	fprintf(ctx->listing, "Syntax error at line %d: %s\n", ctx->lineno, message);
+	fprintf(ctx->listing, "Current token: ");
+	fprintToken(ctx->listing, ctx->token, ctx->tokenString, ctx->tokenLength);
+}
+
+// Skip the Tokens of a Syntax Error, as yacc Does Once It Shifts error
+// They run from the one in error to where recovery ends. A lazy parse
+// skips a block whole, as its yylex would hand it over as a BODY. At
+// ENDFILE, or once MAXSYNTAXERRORS have been met (which is reported),
+// the parse gives up.
+static void recover(Parser *p, Recovery recovery)
+{
+	ParseContext *ctx = p->ctx;
+	TokenType token;
+	if (p->stop) return;
+	while ((token = peek(p)) != SEMI && (token != RCURLY || recovery == RECOVER_SEMI))
+	{
+		int close, values;
+		if (token == ENDFILE)
+		{
+			p->stop = TRUE;
+			return;
+		}
+		if (token == LCURLY && LazyParse && !ctx->body && !ctx->unmatched)
+		{
+			close = matchBrace(p->tokens, p->pos, &values);
+			if (close >= 0)
+			{
+				p->pos = close + 1;
+				p->valuePos += values;
+				continue;
+			}
+			ctx->unmatched = TRUE;
+		}
+		if (token == NUM) p->valuePos++;
+		advance(p);
+	}
+	int last = p->pos;
+	if (token != RCURLY || recovery == RECOVER_DECLARATION_END) advance(p);
+	if (ctx->errors < MAXSYNTAXERRORS)
+	{
+		p->error = FALSE;
+		return;
+	}
+	p->stop = TRUE;
+	if (ctx->listing != NULL)
+		fprintf(ctx->listing, "Too many syntax errors at line %d: parse stopped\n", lineAt(p, last));
+}
+
+// Step Past the Current Token If It Is token, Else Report a Syntax Error
+static int expect(Parser *p, TokenType token)
+{
+	if (peek(p) != token)
+	{
+		syntaxError(p, "syntax error");
+		return FALSE;
+	}
+	advance(p);
+	return TRUE;
+}
+
+// Enter One Level of Nesting (FALSE If Too Deep, for the yacc Parser to Do)
+static int nest(Parser *p)
+{
+	if (++p->depth <= MAXNESTING) return TRUE;
+	p->error = p->stop = TRUE;
+	p->ctx->deep = TRUE;
+	return FALSE;
+}
+
+//----------------
+// Node Building
+//----------------
+static TreeNode *newNode(Parser *p, NodeKind kind, int line)
+{
+	TreeNode *t = newTreeNode(kind);
+	if (t == NULL)
+	{
+		p->error = p->stop = TRUE;
+		p->ctx->error = TRUE;
+		return NULL;
+	}
+	t->lineno = line;
+	return t;
+}
+
+// Append t (Skipped If NULL) to the List from *head to *tail
+static void append(TreeNode **head, TreeNode **tail, TreeNode *t)
+{
+	if (t == NULL) return;
+	if (*head == NULL) *head = t;
+	else
+		(*tail)->sibling = t;
+	*tail = t;
+}
+
+static NodeType arrayOf(NodeType type)
+{
+	if (type == Integer) return IntegerArray;
+	if (type == Void) return VoidArray;
+	return None;
+}
+
+//-------------------
+// Terminal Symbols
+//-------------------
+// Type of an INT or VOID Token (None on a Syntax Error)
+static NodeType typeSpecifier(Parser *p)
+{
+	switch (peek(p))
+	{
+		case INT: advance(p); return Integer;
+		case VOID: advance(p); return Void;
+		default: syntaxError(p, "syntax error"); return None;
+	}
+}
+
+// Name and Line of an ID Token (NULL on a Syntax Error)
+static Atom identifier(Parser *p, int *line)
+{
+	if (peek(p) != ID)
+	{
+		syntaxError(p, "syntax error");
+		return NULL;
+	}
+	TokenBuffer *tokens = p->tokens;
+	Atom name = internName(tokens->text + tokens->offset[p->pos], tokens->length[p->pos]);
+	if (name == NULL)
+	{
+		// Reported and Given Up On, as yacc Does
+		syntaxError(p, "out of memory");
+		p->stop = TRUE;
+		return NULL;
+	}
+	*line = lineAt(p, p->pos);
+	advance(p);
+	return name;
+}
+
+static TreeNode *number(Parser *p)
+{
+	if (peek(p) != NUM)
+	{
+		syntaxError(p, "syntax error");
+		return NULL;
+	}
+	TreeNode *t = newNode(p, ConstExpr, lineAt(p, p->pos));
+	if (t == NULL) return NULL;
+	t->val = p->tokens->value[p->valuePos++];
+	advance(p);
+	return t;
+}
+
+//-------------------------------
+// Expressions (Pratt Parsing)
+//-------------------------------
+static TreeNode *expression(Parser *p);
+
+// Binding Power of a Binary Operator (0 If token Is None)
+static int precedence(TokenType token)
+{
+	switch (token)
+	{
+		case LT:
+		case LE:
+		case GT:
+		case GE:
+		case EQ:
+		case NE: return RELPREC;
+		case PLUS:
+		case MINUS: return RELPREC + 1;
+		case TIMES:
+		case OVER: return RELPREC + 2;
+		default: return 0;
+	}
+}
+
+// Variable or Call Starting at an ID
+static TreeNode *idExpression(Parser *p)
+{
+	int line;
+	Atom name = identifier(p, &line);
+	if (name == NULL) return NULL;
+
+	TreeNode *t;
+	if (peek(p) == LPAREN)
+	{
+		advance(p);
+		t = newNode(p, CallExpr, line);
+		if (t == NULL) return NULL;
+		t->name = name;
+		TreeNode *tail = NULL;
+		if (peek(p) != RPAREN)
+			for (;;)
+			{
+				TreeNode *arg = expression(p);
+				if (arg == NULL) break;
+				append(&t->child[0], &tail, arg);
+				if (peek(p) != COMMA) break;
+				advance(p);
+			}
+		if (p->error || !expect(p, RPAREN))
+		{
+			freeTree(t);
+			return NULL;
+		}
+		return t;
+	}
+
+	t = newNode(p, VarAccessExpr, line);
+	if (t == NULL) return NULL;
+	t->name = name;
+	if (peek(p) == LBRACE)
+	{
+		advance(p);
+		t->child[0] = expression(p);
+		if (t->child[0] == NULL || !expect(p, RBRACE))
+		{
+			freeTree(t);
+			return NULL;
+		}
+	}
+	return t;
+}
+
+// Operand of a Binary Operator
+static TreeNode *factor(Parser *p)
+{
+	TreeNode *t;
+	switch (peek(p))
+	{
+		case LPAREN:
+			advance(p);
+			t = expression(p);
+			if (t != NULL && !expect(p, RPAREN))
+			{
+				freeTree(t);
+				return NULL;
+			}
+			return t;
+		case ID: return idExpression(p);
+		case NUM: return number(p);
+		default: syntaxError(p, "syntax error"); return NULL;
+	}
+}
+
+// Extend left with the Binary Operators Binding at Least minPrec
+static TreeNode *binary(Parser *p, TreeNode *left, int minPrec)
+{
+	int prec;
+	while ((prec = precedence(peek(p))) >= minPrec)
+	{
+		TokenType op = peek(p);
+		advance(p);
+		TreeNode *right = factor(p);
+		if (right != NULL && precedence(peek(p)) > prec) right = binary(p, right, prec + 1);
+		if (right == NULL)
+		{
+			freeTree(left);
+			return NULL;
+		}
+		TreeNode *t = newNode(p, BinOpExpr, left->lineno);
+		if (t == NULL)
+		{
+			freeTree(left);
+			freeTree(right);
+			return NULL;
+		}
+		t->opcode = op;
+		t->child[0] = left;
+		t->child[1] = right;
+		left = t;
+		if (prec == RELPREC) break;
+	}
+	return left;
+}
+
+// Expression, Assignments Included (NULL on a Syntax Error)
+// Only a bare variable is assigned to: (a) = 1 and a + b = 1 stop at
+// the ASSIGN, as the grammar's var ASSIGN expression does.
+static TreeNode *expression(Parser *p)
+{
+	TreeNode *t;
+	if (!nest(p)) return NULL;
+	if (peek(p) == ID)
+	{
+		t = idExpression(p);
+		if (t != NULL && t->kind == VarAccessExpr && peek(p) == ASSIGN)
+		{
+			advance(p);
+			TreeNode *assign = newNode(p, AssignExpr, t->lineno);
+			if (assign == NULL)
+			{
+				freeTree(t);
+				return NULL;
+			}
+			assign->child[0] = t;
+			assign->child[1] = expression(p);
+			if (assign->child[1] == NULL)
+			{
+				freeTree(assign);
+				return NULL;
+			}
+			p->depth--;
+			return assign;
+		}
+	}
+	else
+		t = factor(p);
+	if (t != NULL) t = binary(p, t, RELPREC);
+	p->depth--;
+	return t;
+}
+
+//--------------
+// Statements
+//--------------
+static TreeNode *statement(Parser *p, Recovery recovery);
+
+// Rest of a Variable Declaration after Its Name
+static TreeNode *varDeclaration(Parser *p, NodeType type, Atom name, int line)
+{
+	TreeNode *t = newNode(p, VariableDecl, line);
+	if (t == NULL) return NULL;
+	t->type = type;
+	t->name = name;
+	if (peek(p) == LBRACE)
+	{
+		advance(p);
+		t->type = arrayOf(type);
+		t->child[0] = number(p);
+		if (t->child[0] == NULL || !expect(p, RBRACE))
+		{
+			freeTree(t);
+			return NULL;
+		}
+	}
+	if (!expect(p, SEMI))
+	{
+		freeTree(t);
+		return NULL;
+	}
+	return t;
+}
+
+// TRUE If token Begins a Statement, or Is an Empty One
+static int startsStatement(TokenType token)
+{
+	switch (token)
+	{
+		case IF:
+		case WHILE:
+		case RETURN:
+		case ID:
+		case NUM:
+		case LPAREN:
+		case LCURLY:
+		case SEMI: return TRUE;
+		default: return FALSE;
+	}
+}
+
+static TreeNode *compoundStmt(Parser *p)
+{
+	TreeNode *locals = NULL, *localTail = NULL;
+	TreeNode *stmts = NULL, *stmtTail = NULL;
+	if (!expect(p, LCURLY)) return NULL;
+
+	// Local Declarations, Then Statements, up to the RCURLY
+	for (;;)
+	{
+		TokenType token = peek(p);
+		if (token == INT || token == VOID)
+		{
+			int line;
+			NodeType type = typeSpecifier(p);
+			Atom name = identifier(p, &line);
+			TreeNode *t = name != NULL ? varDeclaration(p, type, name, line) : NULL;
+			if (t != NULL) append(&locals, &localTail, t);
+		}
+		else if (startsStatement(token) || token == RCURLY)
+			break;
+		// An Error before the Statements Begin Is yacc's in the Declarations
+		else
+			syntaxError(p, "syntax error");
+		// A Local Declaration in Error Is Skipped up to a SEMI, as in yacc
+		if (p->error) recover(p, RECOVER_SEMI);
+		if (p->stop) break;
+	}
+	while (!p->error && peek(p) != RCURLY) append(&stmts, &stmtTail, statement(p, RECOVER_BLOCK_END));
+	if (p->error)
+	{
+		freeTree(locals);
+		freeTree(stmts);
+		return NULL;
+	}
+
+	TreeNode *t = newNode(p, CompoundStmt, lineAt(p, p->pos));
+	advance(p);
+	if (t == NULL)
+	{
+		freeTree(locals);
+		freeTree(stmts);
+		return NULL;
+	}
+	t->flag = FALSE;
+	t->child[0] = locals;
+	t->child[1] = stmts;
+	return t;
+}
+
+// Parenthesized Condition of an if or a while
+static TreeNode *condition(Parser *p)
+{
+	if (!expect(p, LPAREN)) return NULL;
+	TreeNode *t = expression(p);
+	if (t != NULL && !expect(p, RPAREN))
+	{
+		freeTree(t);
+		return NULL;
+	}
+	return t;
+}
+
+// Statement (NULL for an Empty One, or on a Syntax Error)
+static TreeNode *statementAt(Parser *p)
+{
+	TreeNode *t, *e;
+	switch (peek(p))
+	{
+		case LCURLY: return compoundStmt(p);
+
+		case IF:
+			advance(p);
+			e = condition(p);
+			if (e == NULL) return NULL;
+			t = newNode(p, IfStmt, e->lineno);
+			if (t == NULL)
+			{
+				freeTree(e);
+				return NULL;
+			}
+			t->child[0] = e;
+			t->child[1] = statement(p, RECOVER_SEMI);
+			// A Trailing else Goes with the Nearest if
+			if (!p->error && peek(p) == ELSE)
+			{
+				advance(p);
+				t->flag = TRUE;
+				t->child[2] = statement(p, RECOVER_SEMI);
+			}
+			else
+				t->flag = FALSE;
+			break;
+
+		case WHILE:
+			advance(p);
+			e = condition(p);
+			if (e == NULL) return NULL;
+			TreeNode *body = statement(p, RECOVER_SEMI);
+			t = newNode(p, WhileStmt, lineAt(p, p->seen));
+			if (t == NULL)
+			{
+				freeTree(e);
+				freeTree(body);
+				return NULL;
+			}
+			t->child[0] = e;
+			t->child[1] = body;
+			break;
+
+		case RETURN:
+			advance(p);
+			e = NULL;
+			if (peek(p) != SEMI)
+			{
+				e = expression(p);
+				if (e == NULL) return NULL;
+			}
+			if (peek(p) != SEMI)
+			{
+				syntaxError(p, "syntax error");
+				freeTree(e);
+				return NULL;
+			}
+			t = newNode(p, ReturnStmt, lineAt(p, p->pos));
+			advance(p);
+			if (t == NULL)
+			{
+				freeTree(e);
+				return NULL;
+			}
+			t->flag = e == NULL;
+			t->child[0] = e;
+			break;
+
+		case SEMI: advance(p); return NULL;
+
+		case ID:
+		case NUM:
+		case LPAREN:
+			t = expression(p);
+			if (t != NULL && !expect(p, SEMI))
+			{
+				freeTree(t);
+				return NULL;
+			}
+			return t;
+
+		default: syntaxError(p, "syntax error"); return NULL;
+	}
+	if (p->error)
+	{
+		freeTree(t);
+		return NULL;
+	}
+	return t;
+}
+
+// Statement, Recovered from If It Has a Syntax Error (Then NULL)
+// yacc pops back to the innermost statement begun, in a statement list
+// or as the body of an if, else or while, the way this one returns.
+static TreeNode *statement(Parser *p, Recovery recovery)
+{
+	int depth = p->depth;
+	if (!nest(p)) return NULL;
+	TreeNode *t = statementAt(p);
+	p->depth = depth;
+	if (p->error)
+	{
+		// What Was Built of It Is Dropped, as yacc Pops It
+		freeTree(t);
+		t = NULL;
+		recover(p, recovery);
+	}
+	return t;
+}
+
+//----------------
+// Declarations
+//----------------
+static TreeNode *params(Parser *p)
+{
+	TreeNode *head = NULL, *tail = NULL;
+	NodeType type;
+	if (peek(p) == VOID)
+	{
+		advance(p);
+		// void Alone Is an Empty List; Its Line Is the One after It
+		if (peek(p) == RPAREN)
+		{
+			TreeNode *t = newNode(p, Params, lineAt(p, p->seen));
+			if (t == NULL) return NULL;
+			t->type = Void;
+			t->flag = TRUE;
+			return t;
+		}
+		type = Void;
+	}
+	else
+		type = typeSpecifier(p);
+
+	while (!p->error)
+	{
+		int line;
+		Atom name = identifier(p, &line);
+		if (name == NULL) break;
+		TreeNode *t = newNode(p, Params, line);
+		if (t == NULL) break;
+		t->type = type;
+		t->name = name;
+		t->flag = FALSE;
+		append(&head, &tail, t);
+		if (peek(p) == LBRACE)
+		{
+			advance(p);
+			t->type = arrayOf(type);
+			if (!expect(p, RBRACE)) break;
+		}
+		if (peek(p) != COMMA) break;
+		advance(p);
+		type = typeSpecifier(p);
+	}
+	if (p->error)
+	{
+		freeTree(head);
+		return NULL;
+	}
+	return head;
+}
+
+static TreeNode *declarationAt(Parser *p)
+{
+	int line;
+	NodeType type = typeSpecifier(p);
+	if (p->error) return NULL;
+	Atom name = identifier(p, &line);
+	if (name == NULL) return NULL;
+	if (peek(p) != LPAREN) return varDeclaration(p, type, name, line);
+
+	advance(p);
+	TreeNode *t = newNode(p, FunctionDecl, line);
+	if (t == NULL) return NULL;
+	t->type = type;
+	t->name = name;
+	t->child[0] = params(p);
+	if (!p->error && expect(p, RPAREN))
+	{
+		// A Lazy Parse Keeps the Body as Its Tokens, up to the Matching Brace
+		int close, values;
+		if (LazyParse && !p->ctx->unmatched && peek(p) == LCURLY)
+		{
+			close = matchBrace(p->tokens, p->pos, &values);
+			if (close >= 0)
+			{
+				t->body = newTokenRange(p->tokens, p->pos, close + 1, p->valuePos);
+				if (t->body == NULL)
+				{
+					freeTree(t);
+					p->error = p->stop = p->ctx->error = TRUE;
+					return NULL;
+				}
+				p->pos = close + 1;
+				p->valuePos += values;
+				return t;
+			}
+			// As yacc's yylex Finds, No Body Is Left after an Unmatched LCURLY
+			p->ctx->unmatched = TRUE;
+		}
+		t->child[1] = compoundStmt(p);
+	}
+	if (p->error)
+	{
+		freeTree(t);
+		return NULL;
+	}
+	t->child[1]->flag = TRUE;
+	return t;
+}
+
+// Declaration, Recovered from If It Has a Syntax Error (Then NULL)
+static TreeNode *declaration(Parser *p)
+{
+	TreeNode *t = declarationAt(p);
+	if (p->error)
+	{
+		freeTree(t);
+		t = NULL;
+		recover(p, RECOVER_DECLARATION_END);
+	}
+	return t;
+}
+
+//-------------------------
+// Descent Parser Functions
+//-------------------------
+// Parse All the Tokens of ctx into a Syntax Tree (NULL If It Gives Up on a Syntax Error)
+TreeNode *descentParse(ParseContext *ctx)
+{
+	TokenBuffer *tokens = ctx->tokens;
+	Parser parser = {ctx, tokens, 0, 0, tokens->valuePos, 0, FALSE, FALSE};
+	Parser *p = &parser;
+	TreeNode *head = NULL, *tail = NULL;
+
+	// One or More Declarations, Then ENDFILE
+	do
+	{
+		TreeNode *t = declaration(p);
+		if (p->stop)
+		{
+			freeTree(head);
+			head = NULL;
+			break;
+		}
+		append(&head, &tail, t);
+	} while (peek(p) != ENDFILE);
+	ctx->lineno = lineAt(p, p->seen);
+	return head;
+}
+
+// Parse the Tokens of ctx as One Function Body (NULL If It Gives Up on a Syntax Error)
+TreeNode *descentParseBody(ParseContext *ctx)
+{
+	TokenBuffer *tokens = ctx->tokens;
+	Parser parser = {ctx, tokens, 0, 0, tokens->valuePos, 0, FALSE, FALSE};
+	Parser *p = &parser;
+	TreeNode *t = compoundStmt(p);
+	// yacc Skips the Tokens in Error as for a Declaration, Then Gives Up
+	if (p->error) recover(p, RECOVER_DECLARATION_END);
+	else if (peek(p) != ENDFILE)
+	{
+		syntaxError(p, "syntax error");
+		freeTree(t);
+		return NULL;
+	}
+	ctx->lineno = lineAt(p, p->seen);
+	return t;
+}
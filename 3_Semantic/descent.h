@@ -0,0 +1,40 @@
+/****************************************************/
+/* File: descent.h                                  */
+/* Recursive descent parser for the C-MINUS         */
+/* compiler (Pratt parsing for expressions)         */
+/****************************************************/
+
+#ifndef _DESCENT_H_
+#define _DESCENT_H_
+
+#include "globals.h"
+#include "tokbuf.h"
+#include "parse.h"
+
+/* MAXNESTING = deepest nesting of statements and
+ * expressions the parser follows; it recurses once
+ * per level, so this bounds the stack it takes.
+ * Deeper code is left to the yacc parser (ctx->deep)
+ */
+#define MAXNESTING 10000
+
+//==================================================================
+// Descent Parser Functions
+//==================================================================
+
+// Parse All the Tokens of ctx into a Syntax Tree (NULL If It Gives Up on a Syntax Error)
+// Builds the tree the yacc parser (cminus.y) builds, node for node
+// and line numbers included, and reports a syntax error on the same
+// token in the same words, to the listing of ctx. Looks at the tokens
+// straight from the buffer, ahead of the cursor of nextToken, which
+// it leaves alone. Recovers from syntax errors where the error rules
+// of the grammar do, skipping the same tokens. Code nested deeper than
+// MAXNESTING is not parsed: ctx->deep is set instead, and nothing more
+// is reported.
+TreeNode *descentParse(ParseContext *ctx);
+// Parse the Tokens of ctx as One Function Body (NULL If It Gives Up on a Syntax Error)
+// The tokens are those of a compound statement, as a lazy parse keeps
+// them, and the tree is the one descentParse builds for it there.
+TreeNode *descentParseBody(ParseContext *ctx);
+
+#endif
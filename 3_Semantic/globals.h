@@ -24,6 +24,11 @@
  * into the Yacc/Bison output itself
  */
 
+/* the parser is pure, and yyparse takes the
+ * ParseContext (parse.h) that it parses into
+ */
+struct ParseContext;
+
 #ifndef YYPARSER
 
 	/* the name of the following file may change */
@@ -81,11 +86,7 @@ typedef enum
 	VarAccessExpr = 0x51,
 	BinOpExpr = 0x52,
 	ConstExpr = 0x53,
-	CallExpr = 0x54,
-	/* For Parser Implementations */
-	Indentifier = 0xf0,
-	TypeSpecifier = 0xf1,
-	Opcode = 0xf2
+	CallExpr = 0x54
 } NodeKind;
 
 // Type Specifier
@@ -107,6 +108,10 @@ typedef enum
 	VariableSym = 0x11
 } SymbolKind;
 
+// Atom: Canonical Copy of a Name from the Intern Pool (intern.h);
+// Equal Names Are the Same Pointer
+typedef const char *Atom;
+
 // TreeNode Structure
 #define MAXCHILDREN 3
 struct ScopeRec;
@@ -120,12 +125,14 @@ typedef struct treeNode
 	NodeKind kind;
 	// Attributes
 	NodeType type;
-	char *name;
+	Atom name;
 	int val;
 	int flag;
 	TokenType opcode;
 	// Scope for Semantic Analysis
 	struct ScopeRec *scope;
+	// Tokens of a Function Body a Lazy Parse Left Unparsed (tokbuf.h)
+	struct TokenRange *body;
 } TreeNode;
 
 // Useful Macros
@@ -157,6 +164,41 @@ extern int EchoSource;
  */
 extern int TraceScan;
 
+/* BufferTokens = TRUE causes the whole source file to
+ * be lexed into a token buffer (see tokbuf.h) before
+ * parsing starts, instead of token by token on demand
+ */
+extern int BufferTokens;
+
+/* BatchLoad = TRUE causes all the sources named on
+ * the command line to be loaded together before the
+ * first is compiled (see loader.h), instead of each
+ * opened with fopen in its turn
+ */
+extern int BatchLoad;
+
+/* DescentParse = TRUE causes programs to be parsed
+ * by the recursive descent parser (see descent.h)
+ * instead of the yacc parser; both build the same
+ * syntax tree
+ */
+extern int DescentParse;
+
+/* ParallelParse = TRUE causes the top-level
+ * declarations of a program to be parsed on one
+ * thread per CPU (see parallel.h); the syntax tree
+ * and any error reported are those of the ordinary
+ * parse
+ */
+extern int ParallelParse;
+
+/* LazyParse = TRUE causes function bodies to be
+ * skipped by brace matching and parsed only when
+ * first asked for (see functionBody in parse.h),
+ * so declarations and signatures cost little
+ */
+extern int LazyParse;
+
 /* TraceParse = TRUE causes the syntax tree to be
  * printed to the listing file in linearized form
  * (using indents for children)
@@ -0,0 +1,163 @@
+/****************************************************/
+/* File: intern.c                                   */
+/* Identifier intern pool implementation for the    */
+/* C-MINUS compiler                                 */
+/****************************************************/
+
+#include "intern.h"
+
+#include <pthread.h>
+
+/* INITBITS = log2 of the initial number of pool buckets */
+#define INITBITS 10
+/* ATOMBLOCK = size of the blocks atoms are carved from */
+#define ATOMBLOCK 65536
+
+//----------------
+// Hash Functions
+//----------------
+// Same Shift-and-Add Hash as symtab.c Used, Reduced Modulo
+// ATOMHASHMOD Instead of SIZE
+#define SHIFT 4
+static unsigned int hash(const char *key, int len)
+{
+	unsigned int temp = 0;
+	for (int i = 0; i < len; ++i) temp = ((temp << SHIFT) + (unsigned char)key[i]) % ATOMHASHMOD;
+	return temp;
+}
+
+// Spread Hash over Pool Buckets (Fibonacci Hashing)
+#define BUCKET(hash, bits) ((unsigned int)((hash) * 2654435769u) >> (32 - (bits)))
+
+//-----------
+// Atom Pool
+//-----------
+// One Pool for the Process, Shared by Parses Running on Several
+// Threads (parse.h). The pool is an open-addressed table of atoms
+// that lookups read without a lock: a slot, once filled, never
+// changes, and a grown table is filled before it is published, so
+// a lookup sees either an atom or an empty slot. Only additions
+// hold poolLock, and look again under it before adding.
+typedef struct AtomTable
+{
+	// Tables Replaced by Growing, Kept for Lookups Still Reading Them
+	struct AtomTable *older;
+	int bits;
+	AtomRec *slot[];
+} AtomTable;
+
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static AtomTable *pool = NULL;
+static int poolCount = 0;
+
+// Atoms Are Never Freed, So They Are Carved from Big Blocks
+static char *block = NULL;
+static size_t blockLeft = 0;
+
+static AtomRec *newAtom(const char *s, int len, unsigned int hashValue)
+{
+	size_t size = offsetof(AtomRec, text) + len + 1;
+	size = (size + _Alignof(AtomRec) - 1) & ~(size_t)(_Alignof(AtomRec) - 1);
+	if (size > blockLeft)
+	{
+		size_t blockSize = size > ATOMBLOCK ? size : ATOMBLOCK;
+		block = (char *)malloc(blockSize);
+		if (block == NULL)
+		{
+			blockLeft = 0;
+			return NULL;
+		}
+		blockLeft = blockSize;
+	}
+	AtomRec *atom = (AtomRec *)block;
+	block += size;
+	blockLeft -= size;
+
+	atom->hash = hashValue;
+	atom->length = len;
+	memcpy(atom->text, s, len);
+	atom->text[len] = '\0';
+	return atom;
+}
+
+// Find the Atom for s in table, or the Empty Slot Where It Would Go (Linear Probing)
+static AtomRec *findSlot(AtomTable *table, const char *s, int len, unsigned int hashValue, unsigned int *idx)
+{
+	unsigned int mask = (1u << table->bits) - 1;
+	for (unsigned int i = BUCKET(hashValue, table->bits);; i = (i + 1) & mask)
+	{
+		AtomRec *atom = __atomic_load_n(&table->slot[i], __ATOMIC_ACQUIRE);
+		if (atom == NULL || (atom->hash == hashValue && atom->length == len && memcmp(atom->text, s, len) == 0))
+		{
+			*idx = i;
+			return atom;
+		}
+	}
+}
+
+// Double the Table, Rehashing with the Stored Hashes; the Caller Holds poolLock
+static int growPool(void)
+{
+	int bits = pool == NULL ? INITBITS : pool->bits + 1;
+	AtomTable *bigger = (AtomTable *)calloc(1, sizeof(AtomTable) + ((size_t)1 << bits) * sizeof(AtomRec *));
+	if (bigger == NULL) return FALSE;
+	bigger->older = pool;
+	bigger->bits = bits;
+	for (int i = 0; pool != NULL && i < (1 << pool->bits); ++i)
+	{
+		AtomRec *atom = pool->slot[i];
+		if (atom == NULL) continue;
+		unsigned int mask = (1u << bits) - 1, idx = BUCKET(atom->hash, bits);
+		while (bigger->slot[idx] != NULL) idx = (idx + 1) & mask;
+		bigger->slot[idx] = atom;
+	}
+	__atomic_store_n(&pool, bigger, __ATOMIC_RELEASE);
+	return TRUE;
+}
+
+//-----------------------
+// Intern Pool Functions
+//-----------------------
+// Find or Add the Atom for s, Whose Hash Is hashValue (NULL If out of Memory); the Caller Holds poolLock
+// Another thread may have added it since the lookup without the lock.
+static Atom lookupName(const char *s, int len, unsigned int hashValue)
+{
+	if (pool == NULL && !growPool()) return NULL;
+
+	// Find Existing Atom
+	unsigned int idx;
+	AtomRec *atom = findSlot(pool, s, len, hashValue, &idx);
+	if (atom != NULL) return atom->text;
+
+	// Add New Atom (Keep Load Factor under 1/2, Which Keeps Probes Short)
+	if (2 * (poolCount + 1) > (1 << pool->bits))
+	{
+		if (!growPool()) return NULL;
+		findSlot(pool, s, len, hashValue, &idx);
+	}
+	atom = newAtom(s, len, hashValue);
+	if (atom == NULL) return NULL;
+	__atomic_store_n(&pool->slot[idx], atom, __ATOMIC_RELEASE);
+	poolCount++;
+	return atom->text;
+}
+
+// Get the Atom for the len Characters at s (Created on First Use, NULL If out of Memory)
+Atom internName(const char *s, int len)
+{
+	// Names Seen Before Are Found without the Lock
+	unsigned int hashValue = hash(s, len), idx;
+	AtomTable *table = __atomic_load_n(&pool, __ATOMIC_ACQUIRE);
+	if (table != NULL)
+	{
+		AtomRec *atom = findSlot(table, s, len, hashValue, &idx);
+		if (atom != NULL) return atom->text;
+	}
+	pthread_mutex_lock(&poolLock);
+	Atom name = lookupName(s, len, hashValue);
+	pthread_mutex_unlock(&poolLock);
+	return name;
+}
+
+// Get the Atom for a NUL-Terminated String
+Atom internString(const char *s) { return internName(s, (int)strlen(s)); }
@@ -0,0 +1,52 @@
+/****************************************************/
+/* File: intern.h                                   */
+/* Identifier intern pool for the C-MINUS compiler  */
+/* (one canonical atom per distinct name)           */
+/****************************************************/
+
+#ifndef _INTERN_H_
+#define _INTERN_H_
+
+#include <stddef.h>
+
+#include "globals.h"
+
+/* ATOMHASHMOD bounds the hash kept in every atom. It
+ * is a multiple of the symbol table SIZE (211), so
+ * ATOMHASH(a) % SIZE is the same bucket the TINY
+ * hash always gave, and listings keep their order
+ */
+#define ATOMHASHMOD (211u << 20)
+
+//==================================================================
+// Data Structures for Intern Pool
+//==================================================================
+
+// Struct: Atom Record
+// An Atom points at text[] of its record, so it prints and reads
+// like an ordinary string, while the record in front of it carries
+// the precomputed hash and length.
+typedef struct AtomRec
+{
+	// Attributes: Hash, Length, Name (NUL terminated)
+	unsigned int hash;
+	int length;
+	char text[];
+} AtomRec;
+
+#define ATOMREC(atom) ((const AtomRec *)((atom) - offsetof(AtomRec, text)))
+#define ATOMHASH(atom) (ATOMREC(atom)->hash)
+#define ATOMLENGTH(atom) (ATOMREC(atom)->length)
+
+//==================================================================
+// Intern Pool Functions
+//==================================================================
+
+// Get the Atom for the len Characters at s (Created on First Use, NULL If out of Memory)
+// Nothing is reported: parses on several threads share the pool, and
+// each reports running out of memory at a line of its own.
+Atom internName(const char *s, int len);
+// Get the Atom for a NUL-Terminated String (NULL If out of Memory)
+Atom internString(const char *s);
+
+#endif
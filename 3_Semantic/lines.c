@@ -0,0 +1,89 @@
+/****************************************************/
+/* File: lines.c                                    */
+/* Newline index implementation for the C-MINUS     */
+/* compiler                                         */
+/****************************************************/
+
+#include "lines.h"
+
+#include "globals.h"
+
+/* WALK = newlines lineOf steps over one by one before
+   it falls back to a binary search */
+#define WALK 8
+
+//------------------------
+// Newline Index Building
+//------------------------
+// Index the Newlines of text[0..len) in One memchr Pass (FALSE If Out of Memory)
+int buildLineIndex(LineIndex *li, const char *text, size_t len)
+{
+	const char *p = text, *end = text + len;
+	int capacity = (int)(len / 32) + 16;
+	li->nl = (unsigned int *)malloc(capacity * sizeof(unsigned int));
+	li->count = 0;
+	li->before = 0;
+	li->cursor = 0;
+	// Empty Range, So the First Lookup Searches
+	li->first = 1;
+	li->last = 0;
+	if (li->nl == NULL) return FALSE;
+	while ((p = (const char *)memchr(p, '\n', end - p)) != NULL)
+	{
+		if (li->count == capacity)
+		{
+			unsigned int *bigger = (unsigned int *)realloc(li->nl, 2 * capacity * sizeof(unsigned int));
+			if (bigger == NULL)
+			{
+				freeLineIndex(li);
+				return FALSE;
+			}
+			li->nl = bigger;
+			capacity *= 2;
+		}
+		li->nl[li->count++] = (unsigned int)(p++ - text);
+	}
+	return TRUE;
+}
+
+//---------------
+// Line Lookups
+//---------------
+// Number of Newlines before pos among nl[lo..hi)
+static int search(const unsigned int *nl, int lo, int hi, size_t pos)
+{
+	while (lo < hi)
+	{
+		int mid = lo + (hi - lo) / 2;
+		if (nl[mid] < pos) lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+// Line Holding Offset pos: One Plus the Newlines before It
+int lineOf(LineIndex *li, size_t pos)
+{
+	int i = li->cursor, stop = i + WALK;
+	// Walk Forward from the Last Lookup, Search Otherwise
+	if (i > 0 && li->nl[i - 1] >= pos) i = search(li->nl, 0, i, pos);
+	else
+	{
+		if (stop > li->count) stop = li->count;
+		while (i < stop && li->nl[i] < pos) i++;
+		if (i == stop && i < li->count && li->nl[i] < pos) i = search(li->nl, i, li->count, pos);
+	}
+	li->cursor = i;
+	li->first = i > 0 ? li->nl[i - 1] + 1 : 0;
+	li->last = i < li->count ? li->nl[i] : (size_t)-1;
+	return i + 1 + li->before;
+}
+
+// Release Newline Index
+void freeLineIndex(LineIndex *li)
+{
+	free(li->nl);
+	li->nl = NULL;
+	li->count = li->cursor = 0;
+}
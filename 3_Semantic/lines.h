@@ -0,0 +1,48 @@
+/****************************************************/
+/* File: lines.h                                    */
+/* Newline index for the C-MINUS compiler (line     */
+/* numbers found from byte offsets on demand)       */
+/****************************************************/
+
+#ifndef _LINES_H_
+#define _LINES_H_
+
+#include <stddef.h>
+
+//==================================================================
+// Data Structures for Newline Index
+//==================================================================
+
+// Struct: Newline Index
+// The offsets of every newline of a text, so the scanner records
+// plain offsets and a token's line is only worked out when asked
+// for. The line of the last lookup is cached as an offset range.
+typedef struct LineIndex
+{
+	// Newline Offsets (ascending)
+	unsigned int *nl;
+	int count;
+	// Lines before the Text, Counted into Every Line Found (0 Once Built):
+	// Set for a Text Cut out of a Longer One
+	int before;
+	// Line of the Last Lookup and the Offsets It Spans
+	int cursor;
+	size_t first, last;
+} LineIndex;
+
+// Line of Offset pos, with a Lookup on the Same Line as the
+// Previous One Done Inline
+#define LINEOF(li, pos) ((pos) >= (li)->first && (pos) <= (li)->last ? (li)->cursor + 1 + (li)->before : lineOf((li), (pos)))
+
+//==================================================================
+// Newline Index Functions
+//==================================================================
+
+// Index the Newlines of text[0..len) in One memchr Pass (FALSE If Out of Memory)
+int buildLineIndex(LineIndex *li, const char *text, size_t len);
+// Line Holding Offset pos: One Plus the Newlines before It
+int lineOf(LineIndex *li, size_t pos);
+// Release Newline Index
+void freeLineIndex(LineIndex *li);
+
+#endif
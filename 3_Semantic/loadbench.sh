@@ -0,0 +1,91 @@
+#!/bin/bash
+#
+# Source loading benchmark: many sources on one command line, loaded
+# in a batch (loader.c) or opened with fopen one by one
+#
+# usage: ./loadbench.sh [-f files] [-n runs]
+#
+# Builds cminus_semantic twice, with BATCH_LOAD TRUE (and LOAD_STATS)
+# and with BATCH_LOAD FALSE, and runs both on the same files: copies
+# of the testcases, in directories of 100. Reports the wall time of a
+# whole run, best of the runs, and its system calls: all of them from
+# strace -f -c when strace is installed, else only the loader's own
+# count (LOAD_STATS) for the batch. Set FLEX or CC to use another flex
+# or compiler.
+
+cd "$(dirname "$0")" || exit 1
+
+files=2000
+runs=5
+while getopts "f:n:" opt; do
+    case $opt in
+        f) files=$OPTARG ;;
+        n) runs=$OPTARG ;;
+        *) echo "usage: $0 [-f files] [-n runs]" >&2; exit 1 ;;
+    esac
+done
+
+flex=${FLEX:-flex}
+if ! command -v "${flex%% *}" > /dev/null 2>&1; then
+    echo "loadbench: $flex not found" >&2
+    exit 1
+fi
+
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+# build NAME BATCH: build $dir/NAME with BATCH_LOAD set to BATCH
+build() {
+    local src="$dir/src-$1"
+    mkdir -p "$src" || return 1
+    cp ./*.c ./*.h ./*.l ./*.y Makefile "$src"/ || return 1
+    make -s -C "$src" FLEX="$flex" ${CC:+CC="$CC"} \
+        CFLAGS="-W -Wall -O2 -DBATCH_LOAD=$2 -DLOAD_STATS=$2" cminus_semantic > /dev/null || return 1
+    mv "$src/cminus_semantic" "$dir/$1"
+}
+
+build batch TRUE || { echo "loadbench: build failed" >&2; exit 1; }
+build fopen FALSE || { echo "loadbench: build failed" >&2; exit 1; }
+
+cases=(testcase/*/*.cm)
+args=()
+for ((i = 0; i < files; i++)); do
+    d="$dir/in/$((i / 100))"
+    [ -d "$d" ] || mkdir -p "$d"
+    f="$d/$i.cm"
+    cp "${cases[i % ${#cases[@]}]}" "$f"
+    args+=("$f")
+done
+
+# best ENGINE: fastest of $runs runs, in nanoseconds
+best() {
+    local t0 t1 t min=
+    for ((i = 0; i < runs; i++)); do
+        t0=$(date +%s%N)
+        "$dir/$1" "${args[@]}" > /dev/null 2>&1
+        t1=$(date +%s%N)
+        t=$((t1 - t0))
+        if [ -z "$min" ] || [ "$t" -lt "$min" ]; then min=$t; fi
+    done
+    echo "$min"
+}
+
+# syscalls ENGINE: system calls of one run
+syscalls() {
+    if command -v strace > /dev/null 2>&1; then
+        strace -f -c -o "$dir/strace" "$dir/$1" "${args[@]}" > /dev/null 2>&1
+        awk '$NF == "total" { print $4 }' "$dir/strace"
+    elif [ "$1" = batch ]; then
+        "$dir/$1" "${args[@]}" 2>&1 > /dev/null | sed -n 's/.* ms, \([0-9]*\) system calls (\(.*\))/\1 (loader, \2)/p'
+    else
+        echo "n/a (no strace)"
+    fi
+}
+
+echo
+echo "$files files, $(cat "${args[@]}" | wc -c) bytes, wall time best of $runs"
+printf "%-8s %12s  %s\n" engine ms "system calls"
+for e in batch fopen; do
+    ns=$(best "$e")
+    printf "%-8s %12.2f  %s\n" "$e" "$(awk -v ns="$ns" 'BEGIN { print ns / 1e6 }')" "$(syscalls "$e")"
+done
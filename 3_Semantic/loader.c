@@ -0,0 +1,474 @@
+/****************************************************/
+/* File: loader.c                                   */
+/* Batched source loading for the C-MINUS compiler  */
+/* (io_uring, or a pool of pread threads)           */
+/****************************************************/
+
+#include "loader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include "globals.h"
+#include "util.h"
+
+/* The ring needs OPENAT, READ and CLOSE, which came
+ * with the 5.6 kernel headers (and their feature flag
+ * IORING_FEAT_RW_CUR_POS)
+ */
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+#define USE_IO_URING TRUE
+#else
+#define USE_IO_URING FALSE
+#endif
+
+/* READCHUNK bounds one read request, whose length
+ * the ring keeps in 32 bits
+ */
+#define READCHUNK ((size_t)1 << 30)
+
+/* Loading Phases: Open and Size Every File; Read; Close */
+typedef enum LoadPhase
+{
+	LOAD_OPEN,
+	LOAD_READ,
+	LOAD_CLOSE,
+} LoadPhase;
+
+//-------------------------------------
+// Buffers & Reads Shared by Both Ways
+//-------------------------------------
+// Give Every Sized File Its Place in One Arena
+static void allocateArena(SourceBatch *batch)
+{
+	size_t total = 0;
+	for (int i = 0; i < batch->count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		if (file->error == 0 && !file->ownsText) total += file->size + 2;
+	}
+	batch->arena = (char *)malloc(total > 0 ? total : 1);
+
+	char *text = batch->arena;
+	for (int i = 0; i < batch->count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		if (file->error != 0 || file->ownsText) continue;
+		if (text == NULL)
+		{
+			file->error = ENOMEM;
+			continue;
+		}
+		file->text = text;
+		text[file->size] = text[file->size + 1] = '\0';
+		text += file->size + 2;
+	}
+}
+
+// Read the Rest of a Sized File from Byte done On (a File That Shrank Ends Early)
+static void finishRead(SourceFile *file, size_t done, long *calls)
+{
+	while (done < file->size)
+	{
+		size_t want = file->size - done;
+		(*calls)++;
+		ssize_t n = pread(file->fd, file->text + done, want < READCHUNK ? want : READCHUNK, (off_t)done);
+		if (n < 0 && errno == EINTR) continue;
+		if (n < 0)
+		{
+			file->error = errno;
+			return;
+		}
+		if (n == 0) break;
+		done += (size_t)n;
+	}
+	file->size = done;
+	file->text[done] = file->text[done + 1] = '\0';
+}
+
+// Size an Open File; One That Has No Size to Go by Gets a Buffer of Its Own
+static void sizeFile(SourceFile *file, long *calls)
+{
+	struct stat st;
+	(*calls)++;
+	if (fstat(file->fd, &st) != 0)
+	{
+		file->error = errno;
+		return;
+	}
+	file->ownsText = !S_ISREG(st.st_mode) || st.st_size == 0;
+	if (!file->ownsText) file->size = (size_t)st.st_size;
+}
+
+// Read a File That Has No Size to Go by (Pipe, Device, Empty) Through stdio; Closes It
+static void readStream(SourceFile *file)
+{
+	FILE *stream = fdopen(file->fd, "r");
+	if (stream == NULL)
+	{
+		file->error = errno;
+		return;
+	}
+	file->text = readSource(stream, &file->size);
+	if (file->text == NULL) file->error = ferror(stream) ? EIO : ENOMEM;
+	fclose(stream);
+	file->fd = -1;
+}
+
+#if USE_IO_URING
+//------------------
+// io_uring Loading
+//------------------
+// Struct: Ring (the Mapped Submission & Completion Queues)
+typedef struct Ring
+{
+	int fd;
+	unsigned entries;
+	// Submission Queue
+	unsigned *sqHead, *sqTail, *sqArray, sqMask;
+	struct io_uring_sqe *sqes;
+	// Completion Queue
+	unsigned *cqHead, *cqTail, cqMask;
+	struct io_uring_cqe *cqes;
+	// Mappings
+	void *sqMap, *cqMap;
+	size_t sqMapSize, cqMapSize, sqesSize;
+} Ring;
+
+static void closeRing(Ring *ring, long *calls)
+{
+	if (ring->sqes != MAP_FAILED)
+	{
+		munmap(ring->sqes, ring->sqesSize);
+		(*calls)++;
+	}
+	if (ring->cqMap != MAP_FAILED && ring->cqMap != ring->sqMap)
+	{
+		munmap(ring->cqMap, ring->cqMapSize);
+		(*calls)++;
+	}
+	if (ring->sqMap != MAP_FAILED)
+	{
+		munmap(ring->sqMap, ring->sqMapSize);
+		(*calls)++;
+	}
+	close(ring->fd);
+	(*calls)++;
+}
+
+// Set Up a Ring of LOADRING Entries (FALSE If the Kernel Has None, or Too Old a One)
+static int openRing(Ring *ring, long *calls)
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	ring->sqMap = ring->cqMap = ring->sqes = MAP_FAILED;
+	(*calls)++;
+	ring->fd = (int)syscall(__NR_io_uring_setup, LOADRING, &params);
+	if (ring->fd < 0) return FALSE;
+	if (!(params.features & IORING_FEAT_RW_CUR_POS))
+	{
+		closeRing(ring, calls);
+		return FALSE;
+	}
+
+	// Map the Queues: One Mapping for Both Rings If the Kernel Allows
+	int single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	ring->sqMapSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	ring->cqMapSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	if (single && ring->cqMapSize > ring->sqMapSize) ring->sqMapSize = ring->cqMapSize;
+	ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	(*calls)++;
+	ring->sqMap = mmap(NULL, ring->sqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+	if (single) ring->cqMap = ring->sqMap;
+	else
+	{
+		(*calls)++;
+		ring->cqMap = mmap(NULL, ring->cqMapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+	}
+	(*calls)++;
+	ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+	if (ring->sqMap == MAP_FAILED || ring->cqMap == MAP_FAILED || ring->sqes == MAP_FAILED)
+	{
+		closeRing(ring, calls);
+		return FALSE;
+	}
+
+	char *sq = (char *)ring->sqMap, *cq = (char *)ring->cqMap;
+	ring->entries = params.sq_entries;
+	ring->sqHead = (unsigned *)(sq + params.sq_off.head);
+	ring->sqTail = (unsigned *)(sq + params.sq_off.tail);
+	ring->sqMask = *(unsigned *)(sq + params.sq_off.ring_mask);
+	ring->sqArray = (unsigned *)(sq + params.sq_off.array);
+	ring->cqHead = (unsigned *)(cq + params.cq_off.head);
+	ring->cqTail = (unsigned *)(cq + params.cq_off.tail);
+	ring->cqMask = *(unsigned *)(cq + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+	return TRUE;
+}
+
+// Fill sqe with the Operation of phase on File i (FALSE If There Is Nothing to Do)
+static int prepareOp(struct io_uring_sqe *sqe, SourceBatch *batch, LoadPhase phase, int i)
+{
+	SourceFile *file = &batch->files[i];
+	memset(sqe, 0, sizeof(*sqe));
+	switch (phase)
+	{
+	case LOAD_OPEN:
+		if (file->fd >= 0) return FALSE;
+		sqe->opcode = IORING_OP_OPENAT;
+		sqe->fd = AT_FDCWD;
+		sqe->addr = (unsigned long)file->name;
+		sqe->open_flags = O_RDONLY | O_CLOEXEC;
+		return TRUE;
+	case LOAD_READ:
+		if (file->fd < 0 || file->error != 0 || file->ownsText || file->size == 0) return FALSE;
+		sqe->opcode = IORING_OP_READ;
+		sqe->fd = file->fd;
+		sqe->addr = (unsigned long)file->text;
+		sqe->len = (unsigned)(file->size < READCHUNK ? file->size : READCHUNK);
+		sqe->off = 0;
+		return TRUE;
+	default:
+		if (file->fd < 0) return FALSE;
+		sqe->opcode = IORING_OP_CLOSE;
+		sqe->fd = file->fd;
+		return TRUE;
+	}
+}
+
+// Take the Result res of the Operation of phase on File i
+static void completeOp(SourceBatch *batch, LoadPhase phase, int i, int res)
+{
+	SourceFile *file = &batch->files[i];
+	switch (phase)
+	{
+	case LOAD_OPEN:
+		if (res >= 0) file->fd = res;
+		else
+			file->error = -res;
+		break;
+	case LOAD_READ:
+		if (res < 0) file->error = -res;
+		else finishRead(file, (size_t)res, &batch->syscalls);
+		break;
+	default:
+		file->fd = -1;
+		break;
+	}
+}
+
+// Run phase on Every File, as Many at Once as the Ring Holds
+// Each io_uring_enter submits what was queued and waits for all in flight.
+static int runRing(Ring *ring, SourceBatch *batch, LoadPhase phase)
+{
+	int ops = batch->count;
+	int next = 0, pending = 0, inFlight = 0;
+	while (next < ops || pending + inFlight > 0)
+	{
+		// Queue Operations into Free Submission Slots
+		unsigned tail = *ring->sqTail;
+		while (next < ops && pending + inFlight < (int)ring->entries)
+		{
+			struct io_uring_sqe *sqe = &ring->sqes[tail & ring->sqMask];
+			if (prepareOp(sqe, batch, phase, next))
+			{
+				sqe->user_data = (unsigned)next;
+				ring->sqArray[tail & ring->sqMask] = tail & ring->sqMask;
+				tail++;
+				pending++;
+			}
+			next++;
+		}
+		__atomic_store_n(ring->sqTail, tail, __ATOMIC_RELEASE);
+		if (pending + inFlight == 0) continue;
+
+		// Submit, and Wait (the Kernel Skips the Wait If It Could Not Submit All)
+		batch->syscalls++;
+		int submitted = (int)syscall(__NR_io_uring_enter, ring->fd, pending, pending + inFlight, IORING_ENTER_GETEVENTS, NULL, 0);
+		if (submitted < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) return FALSE;
+		if (submitted > 0)
+		{
+			pending -= submitted;
+			inFlight += submitted;
+		}
+
+		// Reap Completions
+		unsigned head = *ring->cqHead;
+		unsigned cqTail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+		for (; head != cqTail; head++, inFlight--)
+		{
+			struct io_uring_cqe *cqe = &ring->cqes[head & ring->cqMask];
+			completeOp(batch, phase, (int)cqe->user_data, cqe->res);
+		}
+		__atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+	}
+	return TRUE;
+}
+
+// Load batch Through a Ring (FALSE If io_uring Cannot Be Used; Nothing Is Done Then)
+static int loadByRing(SourceBatch *batch)
+{
+	Ring ring;
+	long calls = 0;
+	if (!openRing(&ring, &calls)) return FALSE;
+	batch->syscalls += calls;
+	batch->usedRing = TRUE;
+
+	// Open Every File, Size Each, Then Read Them All into the Arena and Close Them
+	// The sizes come from fstat: IORING_OP_STATX always goes to a kernel worker
+	// thread, which costs more than the calls it saves when the files are cached.
+	int ok = runRing(&ring, batch, LOAD_OPEN);
+	for (int i = 0; i < batch->count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		if (!ok && file->fd < 0 && file->error == 0) file->error = EIO;
+		if (file->error == 0 && !file->ownsText) sizeFile(file, &batch->syscalls);
+	}
+	allocateArena(batch);
+	ok = ok && runRing(&ring, batch, LOAD_READ);
+	for (int i = 0; i < batch->count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		if (!ok && file->error == 0 && !file->ownsText) file->error = EIO;
+		if (file->error == 0 && file->ownsText) readStream(file);
+	}
+	if (ok) runRing(&ring, batch, LOAD_CLOSE);
+
+	calls = 0;
+	closeRing(&ring, &calls);
+	batch->syscalls += calls;
+	return TRUE;
+}
+#endif
+
+//---------------------------
+// pread Thread Pool Loading
+//---------------------------
+// Struct: Load Pool (Threads Take Files by Index in Turn)
+typedef struct LoadPool
+{
+	SourceBatch *batch;
+	LoadPhase phase;
+	int next;
+} LoadPool;
+
+static void openFile(SourceFile *file, long *calls)
+{
+	if (file->fd >= 0) return;
+	(*calls)++;
+	file->fd = open(file->name, O_RDONLY | O_CLOEXEC);
+	if (file->fd < 0) file->error = errno;
+	else
+		sizeFile(file, calls);
+}
+
+static void *loadWorker(void *arg)
+{
+	LoadPool *pool = (LoadPool *)arg;
+	long calls = 0;
+	int i;
+	while ((i = __atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED)) < pool->batch->count)
+	{
+		SourceFile *file = &pool->batch->files[i];
+		if (pool->phase == LOAD_OPEN)
+		{
+			openFile(file, &calls);
+			continue;
+		}
+		if (file->error == 0 && file->ownsText) readStream(file);
+		else if (file->error == 0) finishRead(file, 0, &calls);
+		if (file->fd >= 0)
+		{
+			close(file->fd);
+			file->fd = -1;
+			calls++;
+		}
+	}
+	__atomic_fetch_add(&pool->batch->syscalls, calls, __ATOMIC_RELAXED);
+	return NULL;
+}
+
+// Run phase on Up to LOADTHREADS Threads, One per CPU, the Calling One Included
+static void runPool(SourceBatch *batch, LoadPhase phase)
+{
+	pthread_t threads[LOADTHREADS];
+	LoadPool pool = { batch, phase, 0 };
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	int n = 0;
+	while (n < LOADTHREADS - 1 && n < cpus - 1 && n < batch->count - 1 && pthread_create(&threads[n], NULL, loadWorker, &pool) == 0) n++;
+	loadWorker(&pool);
+	while (n > 0) pthread_join(threads[--n], NULL);
+}
+
+//------------------------
+// Source Batch Functions
+//------------------------
+// Open and Read the count Named Files into a New Batch (NULL If out of Memory)
+SourceBatch *loadSources(char **names, int count)
+{
+	SourceBatch *batch = (SourceBatch *)calloc(1, sizeof(SourceBatch));
+	if (batch == NULL) return NULL;
+	batch->files = (SourceFile *)calloc(count > 0 ? count : 1, sizeof(SourceFile));
+	if (batch->files == NULL)
+	{
+		free(batch);
+		return NULL;
+	}
+	batch->count = count;
+	for (int i = 0; i < count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		file->name = names[i];
+		file->fd = -1;
+		// "-" Is Standard Input, Read as It Comes
+		if (strcmp(names[i], "-") == 0)
+		{
+			file->fd = STDIN_FILENO;
+			file->ownsText = TRUE;
+		}
+	}
+
+#if USE_IO_URING
+	if (!loadByRing(batch))
+#endif
+	{
+		runPool(batch, LOAD_OPEN);
+		allocateArena(batch);
+		runPool(batch, LOAD_READ);
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		if (file->error == 0) continue;
+		if (file->ownsText) free(file->text);
+		file->text = NULL;
+		file->size = 0;
+	}
+	return batch;
+}
+
+// Release Source Batch and All Its Texts
+void freeSources(SourceBatch *batch)
+{
+	if (batch == NULL) return;
+	for (int i = 0; i < batch->count; ++i)
+	{
+		SourceFile *file = &batch->files[i];
+		if (file->fd >= 0 && file->fd != STDIN_FILENO) close(file->fd);
+		if (file->ownsText) free(file->text);
+	}
+	free(batch->arena);
+	free(batch->files);
+	free(batch);
+}
@@ -0,0 +1,66 @@
+/****************************************************/
+/* File: loader.h                                   */
+/* Batched source loading for the C-MINUS compiler  */
+/* (many sources read up front, few system calls)   */
+/****************************************************/
+
+#ifndef _LOADER_H_
+#define _LOADER_H_
+
+#include <stddef.h>
+
+/* LOADRING = submission queue depth of the io_uring
+ * ring; at most this many opens, reads or closes
+ * are in flight at once
+ */
+#define LOADRING 256
+
+/* LOADTHREADS = most threads of the pread fallback,
+ * which runs one per CPU
+ */
+#define LOADTHREADS 8
+
+//==================================================================
+// Data Structures for Source Batch
+//==================================================================
+
+// Struct: Source File
+// text[0..size) is the file, followed by the two NUL bytes a
+// scanner needs to lex it in place (newBufferScanner). error is 0,
+// or the errno of the open or read that failed, and text is NULL.
+typedef struct SourceFile
+{
+	const char *name;
+	char *text;
+	size_t size;
+	int error;
+	// Internal: Descriptor While Loading, and Whether text Is Outside the Arena
+	int fd;
+	int ownsText;
+} SourceFile;
+
+// Struct: Source Batch
+// The texts of regular files share one arena, sized from their
+// lengths before any of them is read; others (pipes, devices) are
+// read into buffers of their own.
+typedef struct SourceBatch
+{
+	SourceFile *files;
+	int count;
+	char *arena;
+	// Statistics: System Calls Loading Took, and How They Were Made
+	long syscalls;
+	int usedRing;
+} SourceBatch;
+
+//==================================================================
+// Source Batch Functions
+//==================================================================
+
+// Open and Read the count Named Files into a New Batch (NULL If out of Memory)
+// Uses io_uring where the kernel has it, else a pool of pread threads.
+SourceBatch *loadSources(char **names, int count);
+// Release Source Batch and All Its Texts
+void freeSources(SourceBatch *batch);
+
+#endif
@@ -7,10 +7,68 @@
 
 #include "globals.h"
 
-/* set NO_PARSE to TRUE to get a scanner-only compiler */
+#include <errno.h>
+#include <time.h>
+
+/* set NO_PARSE to TRUE to get a scanner-only compiler
+ * (as the bench target does)
+ */
+#ifndef NO_PARSE
 #define NO_PARSE FALSE
-/* set NO_ANALYZE to TRUE to get a parser-only compiler */
+#endif
+/* set NO_ANALYZE to TRUE to get a parser-only compiler
+ * (as the parsebench target does)
+ */
+#ifndef NO_ANALYZE
 #define NO_ANALYZE FALSE
+#endif
+
+/* set BATCH_LOAD to FALSE to open and read every
+ * source with fopen as it is compiled, instead of
+ * loading them all up front (see loader.h)
+ */
+#ifndef BATCH_LOAD
+#define BATCH_LOAD TRUE
+#endif
+
+/* set DESCENT_PARSE to TRUE to parse with the
+ * recursive descent parser instead of the yacc one
+ */
+#ifndef DESCENT_PARSE
+#define DESCENT_PARSE FALSE
+#endif
+
+/* set PARALLEL_PARSE to TRUE to parse the top-level
+ * declarations of each program on several threads
+ */
+#ifndef PARALLEL_PARSE
+#define PARALLEL_PARSE FALSE
+#endif
+
+/* set LAZY_PARSE to TRUE to parse function bodies
+ * apart, after the declarations, just before the
+ * analysis
+ */
+#ifndef LAZY_PARSE
+#define LAZY_PARSE FALSE
+#endif
+
+/* set SIGNATURES_ONLY to TRUE to list only the
+ * functions and global symbols of each program
+ * (printFunction, printGlobal), from a lazy parse
+ * whose function bodies are never parsed
+ */
+#ifndef SIGNATURES_ONLY
+#define SIGNATURES_ONLY FALSE
+#endif
+
+/* set LOAD_STATS to TRUE to report to stderr how
+ * long loading the sources took, and in how many
+ * system calls when they were batched
+ */
+#ifndef LOAD_STATS
+#define LOAD_STATS FALSE
+#endif
 
 /* set NO_CODE to TRUE to get a compiler that does not
  * generate code
@@ -18,12 +76,14 @@
 #define NO_CODE TRUE
 
 #include "util.h"
+#include "loader.h"
 #if NO_PARSE
 	#include "scan.h"
 #else
 	#include "parse.h"
 	#if !NO_ANALYZE
 		#include "analyze.h"
+		#include "symtab.h"
 		#if !NO_CODE
 			#include "cgen.h"
 		#endif
@@ -39,42 +99,49 @@ FILE *code;
 /* allocate and set tracing flags */
 int EchoSource = FALSE;
 int TraceScan = FALSE;
+int BufferTokens = TRUE;
 int TraceParse = FALSE;
 int TraceAnalyze = FALSE;
 int TraceCode = FALSE;
+int BatchLoad = BATCH_LOAD;
+int DescentParse = DESCENT_PARSE;
+int ParallelParse = PARALLEL_PARSE;
+int LazyParse = LAZY_PARSE || SIGNATURES_ONLY;
 
 int Error = FALSE;
 
-int main(int argc, char *argv[])
+/* compile runs the passes on one program: on text,
+ * when it was loaded in a batch, or else on source
+ */
+static void compile(char *pgm, char *text, size_t size)
 {
-	TreeNode *syntaxTree;
-	char pgm[120]; /* source code file name */
-	if (argc != 2)
-	{
-		fprintf(stderr, "usage: %s <filename>\n", argv[0]);
-		exit(1);
-	}
-	strcpy(pgm, argv[1]);
-	if (strchr(pgm, '.') == NULL) strcat(pgm, ".tny");
-	source = fopen(pgm, "r");
-	if (source == NULL)
-	{
-		fprintf(stderr, "File %s not found\n", pgm);
-		exit(1);
-	}
-	listing = stdout; /* send listing to screen */
 	fprintf(listing, "\nC-MINUS COMPILATION: %s\n", pgm);
 #if NO_PARSE
-	while (getToken() != ENDFILE)
-		;
+	ScanContext *scan = text != NULL ? newBufferScanner(text, size) : newScanner(source);
+	if (scan != NULL)
+	{
+		while (getToken(scan) != ENDFILE)
+			;
+		freeScanner(scan);
+	}
 #else
-	syntaxTree = parse();
+	TreeNode *syntaxTree = text != NULL ? parseBuffer(text, size) : parse();
 	if (TraceParse)
 	{
 		fprintf(listing, "\nSyntax tree:\n");
 		printTree(syntaxTree);
 	}
 	#if !NO_ANALYZE
+		#if SIGNATURES_ONLY
+	/* the signatures need no body, so those a lazy
+	 * parse left go unparsed, freed with the tree
+	 */
+	if (!Error) buildSignatures(syntaxTree);
+		#else
+	/* a program is type checked only once every body
+	 * a lazy parse left is parsed, and none has errors
+	 */
+	if (!Error && !parseBodies(syntaxTree, listing)) Error = TRUE;
 	if (!Error)
 	{
 		if (TraceAnalyze) fprintf(listing, "\nBuilding Symbol Table...\n");
@@ -83,7 +150,8 @@ int main(int argc, char *argv[])
 		typeCheck(syntaxTree);
 		if (TraceAnalyze) fprintf(listing, "\nType Checking Finished\n");
 	}
-		#if !NO_CODE
+		#endif
+		#if !NO_CODE && !SIGNATURES_ONLY
 	if (!Error)
 	{
 		char *codefile;
@@ -101,9 +169,101 @@ int main(int argc, char *argv[])
 		fclose(code);
 	}
 		#endif
+	freeSymbolTable();
 	#endif
+	freeTree(syntaxTree);
 #endif
-	fclose(source);
-	return 0;
 }
 
+/* reportSourceError tells why pgm could not be
+ * opened or read, from the errno error
+ */
+static void reportSourceError(const char *pgm, int error)
+{
+	if (error == ENOENT) fprintf(stderr, "File %s not found\n", pgm);
+	else
+		fprintf(stderr, "File %s: %s\n", pgm, strerror(error));
+}
+
+int main(int argc, char *argv[])
+{
+	int count = argc - 1;
+	if (count < 1)
+	{
+		fprintf(stderr, "usage: %s <filename>|- ...\n", argv[0]);
+		exit(1);
+	}
+
+	// Source File Names: "-" Reads Standard Input
+	char **pgms = (char **)malloc(count * sizeof(char *));
+	if (pgms == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		char *pgm = argv[i + 1];
+		if (strcmp(pgm, "-") != 0)
+		{
+			pgm = (char *)malloc(strlen(argv[i + 1]) + 5);
+			if (pgm == NULL)
+			{
+				fprintf(stderr, "Out of memory\n");
+				exit(1);
+			}
+			strcpy(pgm, argv[i + 1]);
+			if (strchr(pgm, '.') == NULL) strcat(pgm, ".tny");
+		}
+		pgms[i] = pgm;
+	}
+	listing = stdout; /* send listing to screen */
+
+	// Load All Sources Up Front, with Batched System Calls
+	SourceBatch *batch = NULL;
+	if (BatchLoad && count > 1)
+	{
+		struct timespec t0, t1;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		batch = loadSources(pgms, count);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		if (LOAD_STATS && batch != NULL)
+			fprintf(stderr, "loaded %d files in %.3f ms, %ld system calls (%s)\n", count,
+					(t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6, batch->syscalls,
+					batch->usedRing ? "io_uring" : "pread threads");
+	}
+
+	// A Source That Cannot Be Read Is Reported, and the Others Still Compiled
+	int failed = FALSE;
+	for (int i = 0; i < count; ++i)
+	{
+		char *pgm = pgms[i];
+		if (batch != NULL)
+		{
+			SourceFile *file = &batch->files[i];
+			if (file->error != 0)
+			{
+				reportSourceError(pgm, file->error);
+				failed = TRUE;
+				continue;
+			}
+			compile(pgm, file->text, file->size);
+		}
+		else
+		{
+			source = strcmp(pgm, "-") == 0 ? stdin : fopen(pgm, "r");
+			if (source == NULL)
+			{
+				reportSourceError(pgm, errno);
+				failed = TRUE;
+				continue;
+			}
+			compile(pgm, NULL, 0);
+			fclose(source);
+		}
+		// Next Program Starts with a Clean Slate
+		Error = FALSE;
+	}
+	freeSources(batch);
+	return failed ? 1 : 0;
+}
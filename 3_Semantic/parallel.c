@@ -0,0 +1,176 @@
+/****************************************************/
+/* File: parallel.c                                 */
+/* Parallel parser implementation for the C-MINUS   */
+/* compiler                                         */
+/****************************************************/
+
+#include "parallel.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "tokbuf.h"
+#include "util.h"
+
+//-----------------
+// Chunks
+//-----------------
+// Struct: Chunk
+// Tokens [start, end) of whole top-level declarations, valueStart the
+// index into value[] of their first NUM, and what parsing them gave.
+typedef struct Chunk
+{
+	int start;
+	int end;
+	int valueStart;
+	TreeNode *tree;
+	int error;
+} Chunk;
+
+static int addChunk(Chunk **chunks, int *count, int *capacity, int start, int end, int valueStart)
+{
+	if (*count == *capacity)
+	{
+		int bigger = *capacity * 2;
+		Chunk *grown = (Chunk *)realloc(*chunks, bigger * sizeof(Chunk));
+		if (grown == NULL) return FALSE;
+		*chunks = grown;
+		*capacity = bigger;
+	}
+	Chunk *chunk = &(*chunks)[(*count)++];
+	chunk->start = start;
+	chunk->end = end;
+	chunk->valueStart = valueStart;
+	chunk->tree = NULL;
+	chunk->error = FALSE;
+	return TRUE;
+}
+
+// Cut the Tokens before ENDFILE into Chunks of at Least target Tokens (NULL If out of Memory)
+// A declaration ends at a SEMI or a closing brace outside all braces.
+// Tokens that do not end so, in a wrong program, go to the last chunk,
+// whose parse then fails like the parse of the whole program does.
+static Chunk *splitDeclarations(TokenBuffer *tokens, int target, int *count)
+{
+	int capacity = 16, start = 0, depth = 0, values = 0, valueStart = 0;
+	Chunk *chunks = (Chunk *)malloc(capacity * sizeof(Chunk));
+	if (chunks == NULL) return NULL;
+	*count = 0;
+	for (int i = 0; i < tokens->count - 1; i++)
+	{
+		unsigned char kind = tokens->kind[i];
+		if (kind == TOKEN2KIND(NUM)) values++;
+		else if (kind == TOKEN2KIND(LCURLY)) depth++;
+		else if (kind == TOKEN2KIND(RCURLY)) depth--;
+		if (depth != 0 || (kind != TOKEN2KIND(SEMI) && kind != TOKEN2KIND(RCURLY)) || i + 1 - start < target) continue;
+		if (!addChunk(&chunks, count, &capacity, start, i + 1, valueStart))
+		{
+			free(chunks);
+			return NULL;
+		}
+		start = i + 1;
+		valueStart = values;
+	}
+	if (start < tokens->count - 1 && !addChunk(&chunks, count, &capacity, start, tokens->count - 1, valueStart))
+	{
+		free(chunks);
+		return NULL;
+	}
+	return chunks;
+}
+
+//-----------------
+// Worker Threads
+//-----------------
+// Struct: Parse Pool
+// Workers take the chunks in order through next.
+typedef struct ParsePool
+{
+	TokenBuffer *tokens;
+	Chunk *chunks;
+	int count;
+	int next;
+} ParsePool;
+
+// Parse One Chunk as a Program of Its Own, through a View of the Buffer
+static void parseChunk(TokenBuffer *tokens, Chunk *chunk)
+{
+	TokenBuffer view;
+	if (!viewTokens(tokens, chunk->start, chunk->end, chunk->valueStart, &view))
+	{
+		chunk->error = TRUE;
+		return;
+	}
+
+	// No Listing: a Syntax Error Is Reported by the Parse Done Again
+	ParseContext ctx;
+	initParse(&ctx, NULL);
+	ctx.tokens = &view;
+	chunk->tree = parseInput(&ctx);
+	chunk->error = ctx.error;
+	freeTokenView(&view);
+}
+
+static void *parseWorker(void *arg)
+{
+	ParsePool *pool = (ParsePool *)arg;
+	int i;
+	while ((i = __atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED)) < pool->count) parseChunk(pool->tokens, &pool->chunks[i]);
+	return NULL;
+}
+
+//--------------------------
+// Parallel Parser Functions
+//--------------------------
+// Parse the Tokens of ctx on Several Threads (NULL If It Gives Up on a Syntax Error)
+TreeNode *parallelParse(ParseContext *ctx)
+{
+	TokenBuffer *tokens = ctx->tokens;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 2) return parseInput(ctx);
+	int threads = (int)cpus;
+
+	int target = tokens->count / (threads * CHUNKSPERTHREAD), count;
+	if (target < PARSECHUNK) target = PARSECHUNK;
+	Chunk *chunks = splitDeclarations(tokens, target, &count);
+	if (chunks == NULL || count < 2)
+	{
+		free(chunks);
+		return parseInput(ctx);
+	}
+
+	// Up to threads Threads, the Calling One Included, but No More than Chunks
+	if (threads > count) threads = count;
+	pthread_t *workers = (pthread_t *)malloc((threads - 1) * sizeof(pthread_t));
+	ParsePool pool = {tokens, chunks, count, 0};
+	int n = 0;
+	if (workers != NULL)
+		while (n < threads - 1 && pthread_create(&workers[n], NULL, parseWorker, &pool) == 0) n++;
+	parseWorker(&pool);
+	while (n > 0) pthread_join(workers[--n], NULL);
+	free(workers);
+
+	int error = FALSE;
+	for (int i = 0; i < count; i++) error |= chunks[i].error;
+	if (error)
+	{
+		for (int i = 0; i < count; i++) freeTree(chunks[i].tree);
+		free(chunks);
+		return parseInput(ctx);
+	}
+
+	// Link the Chunk Lists in Source Order
+	TreeNode *head = NULL, *tail = NULL;
+	for (int i = 0; i < count; i++)
+	{
+		if (tail == NULL) head = chunks[i].tree;
+		else
+			tail->sibling = chunks[i].tree;
+		for (tail = chunks[i].tree; tail->sibling != NULL; tail = tail->sibling)
+			;
+	}
+	free(chunks);
+	ctx->tree = head;
+	ctx->lineno = LINEOF(&tokens->lines, tokens->offset[tokens->count - 1]);
+	return head;
+}
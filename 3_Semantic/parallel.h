@@ -0,0 +1,38 @@
+/****************************************************/
+/* File: parallel.h                                 */
+/* Parallel parsing of top-level declarations for   */
+/* the C-MINUS compiler                             */
+/****************************************************/
+
+#ifndef _PARALLEL_H_
+#define _PARALLEL_H_
+
+#include "globals.h"
+#include "parse.h"
+
+/* PARSECHUNK = fewest tokens handed to a thread at
+ * once; smaller declarations are parsed in runs
+ */
+#define PARSECHUNK 4096
+
+/* CHUNKSPERTHREAD = chunks a program is cut into per
+ * thread, so threads that finish early take more
+ */
+#define CHUNKSPERTHREAD 4
+
+//==================================================================
+// Parallel Parser Functions
+//==================================================================
+
+// Parse the Tokens of ctx on Several Threads (NULL If It Gives Up on a Syntax Error)
+// Finds where the top-level declarations end by matching braces, cuts
+// the tokens there into chunks, and parses them on one thread per CPU
+// online, no more threads than chunks. Each chunk is parsed with its
+// own context, as a program of its own, with the engine DescentParse
+// selects. The chunk lists are then linked in source order. A program
+// with a syntax error anywhere is parsed again from the start on the
+// calling thread, so the error and the tree are those of an ordinary
+// parse. Leaves the tokens in ctx.
+TreeNode *parallelParse(ParseContext *ctx);
+
+#endif
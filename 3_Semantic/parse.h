@@ -8,9 +8,119 @@
 #ifndef _PARSE_H_
 #define _PARSE_H_
 
+/* MAXSYNTAXERRORS = syntax errors one parse reports
+ * before it gives up on the rest of the program
+ */
+#define MAXSYNTAXERRORS 20
+
+/* ParseContext holds everything one parse owns, so
+ * several programs can be parsed at once (each on
+ * its own thread if need be): the tokens or scanner
+ * it reads, the token being parsed, the line counter,
+ * the error state and the tree built. Nothing of a
+ * parse is kept in globals; the flags that choose how
+ * to parse (BufferTokens, DescentParse, ParallelParse,
+ * LazyParse, TraceScan) are only read
+ */
+typedef struct ParseContext
+{
+	// Input, Set Up and Released by the Parse
+	struct TokenBuffer *tokens;
+	struct ScanContext *scanner;
+	// TRUE to Parse the Tokens as One Function Body (a Compound
+	// Statement) instead of a Program, as functionBody Does
+	int body;
+	// TRUE Once a Lazy Parse Met an LCURLY Matched by No RCURLY: All
+	// the Tokens after It Are Inside It, So No Body Is Left of Them
+	int unmatched;
+	// Token Being Parsed: Kind, Lexeme (a View into the Source),
+	// Value If a NUM, and Line
+	TokenType token;
+	const char *tokenString;
+	unsigned int tokenLength;
+	int tokenValue;
+	int lineno;
+	// Syntax Errors Are Written to listing (Only Flagged If NULL);
+	// error Is TRUE after One, errors Counts Them
+	FILE *listing;
+	int error;
+	int errors;
+	// How Many of the First Syntax Errors Not to Write: Those the
+	// Descent Parser Wrote before Handing the Program to yacc
+	int silent;
+	// TRUE If the Descent Parser Gave Up on Nesting Deeper than
+	// MAXNESTING (descent.h), Which parseInput Then Hands to yacc
+	int deep;
+	// Syntax Tree (the Caller's to Free)
+	TreeNode *tree;
+} ParseContext;
+
+/* Procedure initParse readies ctx for a parse that
+ * reports syntax errors to listing
+ */
+void initParse(ParseContext *ctx, FILE *listing);
+
+/* Function parseFile parses all of file with ctx and
+ * returns the tree, also left in ctx->tree. After a
+ * syntax error ctx->error is set, and the parse
+ * skips to the end of the statement or declaration
+ * in error, a SEMI or an RCURLY, and goes on, so
+ * every error is reported, up to MAXSYNTAXERRORS,
+ * after which a last line tells the parse stopped.
+ * The tree then lacks what was skipped; it is NULL
+ * if the parse gives up, at ENDFILE while skipping
+ * or on error MAXSYNTAXERRORS. Running out of memory
+ * or failing to read file also sets ctx->error, once
+ * reported to listing
+ */
+TreeNode *parseFile(ParseContext *ctx, FILE *file);
+
+/* Function parseText is parseFile on text[0..size),
+ * which must be followed by two NUL bytes; the text
+ * is written to as it is lexed
+ */
+TreeNode *parseText(ParseContext *ctx, char *text, size_t size);
+
+/* Function parseInput parses the tokens or scanner
+ * already set up in ctx on the calling thread, with
+ * the parser DescentParse selects, and returns the
+ * tree; it leaves them to the caller to release.
+ * Code nested too deep for the descent parser is
+ * parsed by the yacc parser, whose stacks grow on
+ * the heap
+ */
+TreeNode *parseInput(ParseContext *ctx);
+
+/* Function functionBody returns the body of the
+ * FunctionDecl fn, parsing it first if a parse with
+ * LazyParse set left it as tokens (fn->body); its
+ * syntax errors are then written to listing (only
+ * flagged if NULL) and set *error, which is left
+ * alone otherwise, so bodies on several threads
+ * each report to their own. The text of parseText
+ * or parseBuffer must outlive every body left
+ * unparsed
+ */
+TreeNode *functionBody(TreeNode *fn, FILE *listing, int *error);
+
+/* Function parseBodies parses every function body
+ * of the declarations in tree that a lazy parse left
+ * as tokens, as functionBody does, so each syntax
+ * error is reported to listing before the tree is
+ * analyzed. It returns FALSE if any body had one
+ */
+int parseBodies(TreeNode *tree, FILE *listing);
+
 /* Function parse returns the newly
- * constructed syntax tree
+ * constructed syntax tree of the source
+ * file, setting Error and lineno as it goes
  */
 TreeNode *parse(void);
 
+/* Function parseBuffer parses text[0..size), which
+ * must be followed by two NUL bytes, instead of the
+ * source file; the text is written to as it is lexed
+ */
+TreeNode *parseBuffer(char *text, size_t size);
+
 #endif
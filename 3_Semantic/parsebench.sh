@@ -0,0 +1,298 @@
+#!/bin/bash
+#
+# Parser benchmark: parsing speed in nodes per second, scaling on
+# programs made of one ever longer list, and on ever deeper nesting
+#
+# usage: ./parsebench.sh [-m megabytes] [-s sizes] [-d depths] [-n runs] [-r revision]
+#
+# Builds a parser-only cminus_parse_bench (main.c with NO_ANALYZE and
+# cminus.y with PARSE_STATS) for each engine: the yacc parser and the
+# descent parser (DESCENT_PARSE), each also parsing declarations on
+# one thread per CPU (PARALLEL_PARSE, the -par engines) and leaving
+# function bodies unparsed (LAZY_PARSE, the -lazy engines), and, with -r,
+# the yacc parser again from the sources as of that git revision (one
+# that has this benchmark), to compare against an earlier parser.
+#
+# Speed: every engine but the -r one parses one program of about
+# megabytes (default 4) made of the testcases over and over. Reports
+# the nodes built, the parse time alone (PARSE_STATS, so lexing is left
+# out) and millions of nodes a second, best of the runs. The -par
+# engines only gain on a machine with more than one CPU. The -lazy
+# engines build the declarations and their parameters alone, so their
+# time is what an index of the function signatures costs.
+#
+# Scaling: for each size n in sizes (default 4000 to 64000, doubling)
+# the yacc, descent and -r engines parse programs whose one list is n long: global
+# declarations, parameters, local declarations, statements and call
+# arguments. Reports nanoseconds per list element of a whole run, best
+# of the runs, less the time of an empty program. A parser that builds
+# lists in linear time keeps the same figure as n grows; the last
+# column, growth, is the time at the largest n over the time at the
+# smallest, divided by the ratio of the sizes (about 1 when linear,
+# about that ratio when quadratic).
+#
+# Nesting: for each depth d in depths (default 10000 to 1000000, by
+# tens) the yacc and descent engines parse programs nested d deep:
+# parentheses, blocks, if statements, assignments and calls. Reports
+# nanoseconds and bytes of peak memory per level (parse time alone and
+# peak resident size, from PARSE_STATS), best of the runs, less those
+# of an empty program, with the growth of each as above. The parser
+# stacks grow on the heap, so both stay flat however deep the nesting.
+#
+# Set FLEX or CC to use another flex or compiler.
+
+cd "$(dirname "$0")" || exit 1
+
+size=4
+sizes="4000 8000 16000 32000 64000"
+depths="10000 100000 1000000"
+runs=3
+rev=
+while getopts "m:s:d:n:r:" opt; do
+    case $opt in
+        m) size=$OPTARG ;;
+        s) sizes=$OPTARG ;;
+        d) depths=$OPTARG ;;
+        n) runs=$OPTARG ;;
+        r) rev=$OPTARG ;;
+        *) echo "usage: $0 [-m megabytes] [-s sizes] [-d depths] [-n runs] [-r revision]" >&2; exit 1 ;;
+    esac
+done
+
+flex=${FLEX:-flex}
+if ! command -v "${flex%% *}" > /dev/null 2>&1; then
+    echo "parsebench: $flex not found" >&2
+    exit 1
+fi
+
+dir=$(mktemp -d) || exit 1
+trap 'rm -rf "$dir"' EXIT
+
+# build ENGINE DEFINES [REV]: build $dir/ENGINE with the -D options
+# DEFINES, from the sources of REV if given
+build() {
+    local src="$dir/src-${1//\//_}"
+    mkdir -p "$src" || return 1
+    if [ -n "$3" ]; then
+        git archive "$3" . | tar -x -C "$src" || return 1
+    else
+        cp ./*.c ./*.h ./*.l ./*.y Makefile "$src"/ || return 1
+    fi
+    make -s -C "$src" FLEX="$flex" ${CC:+CC="$CC"} \
+        CFLAGS="-W -Wall $2 -DPARSE_STATS=TRUE" cminus_parse_bench > /dev/null || return 1
+    mv "$src/cminus_parse_bench" "$dir/${1//\//_}"
+}
+
+# program LIST N: a program with a LIST list of N elements
+program() {
+    awk -v list="$1" -v n="$2" 'BEGIN {
+        if (list == "globals") {
+            for (i = 0; i < n; i++) print "int g;"
+            print "void main(void) { }"
+        } else if (list == "params") {
+            print "void f(int a"
+            for (i = 1; i < n; i++) print ", int a"
+            print ") { }"
+        } else {
+            print "void main(void)"
+            print "{"
+            if (list == "locals") for (i = 0; i < n; i++) print "  int x;"
+            else if (list == "statements") for (i = 0; i < n; i++) print "  x = 1;"
+            else {
+                print "  f(0"
+                for (i = 1; i < n; i++) print "    , 0"
+                print "  );"
+            }
+            print "}"
+        }
+    }'
+}
+
+# nested KIND D: a program nested D deep in KIND
+nested() {
+    awk -v kind="$1" -v d="$2" 'BEGIN {
+        if (kind == "blocks") {
+            print "void main(void)"
+            for (i = 0; i < d; i++) print "{"
+            for (i = 0; i < d; i++) print "}"
+            exit
+        }
+        if (kind == "calls") print "int f(int a) { return a; }"
+        print "void main(void)"
+        print "{"
+        print "  int x;"
+        if (kind == "ifs") {
+            for (i = 0; i < d; i++) print "  if (x)"
+            print "  x = 1;"
+        } else {
+            printf "  x ="
+            left = kind == "parens" ? " (" : kind == "calls" ? " f(" : " x ="
+            right = kind == "assigns" ? "" : ")"
+            for (i = 0; i < d; i++) printf "%s", left
+            printf " 1"
+            for (i = 0; i < d; i++) printf "%s", right
+            print ";"
+        }
+        print "}"
+    }'
+}
+
+# best ENGINE FILE: fastest of $runs runs, in nanoseconds
+best() {
+    local t0 t1 t min=
+    for ((i = 0; i < runs; i++)); do
+        t0=$(date +%s%N)
+        "$dir/$1" "$2" > /dev/null 2>&1 || return 1
+        t1=$(date +%s%N)
+        t=$((t1 - t0))
+        if [ -z "$min" ] || [ "$t" -lt "$min" ]; then min=$t; fi
+    done
+    echo "$min"
+}
+
+# speed ENGINE FILE: best of $runs runs as "nodes ms", from PARSE_STATS
+speed() {
+    local line nodes ms best= bestNodes=
+    for ((i = 0; i < runs; i++)); do
+        line=$("$dir/$1" "$2" 2>&1 > /dev/null | grep '^parsed ')
+        [ -n "$line" ] || return 1
+        nodes=$(echo "$line" | awk '{ print $2 }')
+        ms=$(echo "$line" | awk '{ print $5 }')
+        if [ -z "$best" ] || awk -v a="$ms" -v b="$best" 'BEGIN { exit !(a < b) }'; then
+            best=$ms bestNodes=$nodes
+        fi
+    done
+    echo "$bestNodes $best"
+}
+
+# footprint ENGINE FILE: best of $runs runs as "ms KB", parse time and
+# peak memory from PARSE_STATS
+footprint() {
+    local line ms kb best= bestKB=
+    for ((i = 0; i < runs; i++)); do
+        line=$("$dir/$1" "$2" 2>&1 > /dev/null | grep '^parsed ')
+        [ -n "$line" ] || return 1
+        ms=$(echo "$line" | awk '{ print $5 }')
+        kb=$(echo "$line" | awk '{ print $(NF - 1) }')
+        if [ -z "$best" ] || awk -v a="$ms" -v b="$best" 'BEGIN { exit !(a < b) }'; then best=$ms; fi
+        if [ -z "$bestKB" ] || [ "$kb" -lt "$bestKB" ]; then bestKB=$kb; fi
+    done
+    echo "$best $bestKB"
+}
+
+# growth T0 T N0 N: T over T0 divided by N over N0, or - if T0 is 0
+growth() {
+    if [ "$4" != "$3" ] && awk -v t0="$1" 'BEGIN { exit !(t0 > 0) }'; then
+        awk -v t="$2" -v t0="$1" -v n="$4" -v n0="$3" 'BEGIN { printf " %8.2f", t / t0 / (n / n0) }'
+    else
+        printf " %8s" -
+    fi
+}
+
+engines=()
+current=()
+for e in yacc descent yacc-par descent-par yacc-lazy descent-lazy; do
+    defines=
+    case $e in descent*) defines="-DDESCENT_PARSE=TRUE" ;; esac
+    case $e in *-par) defines="$defines -DPARALLEL_PARSE=TRUE" ;; esac
+    case $e in *-lazy) defines="$defines -DLAZY_PARSE=TRUE" ;; esac
+    if build "$e" "$defines"; then
+        current+=("$e")
+        case $e in *-par | *-lazy) ;; *) engines+=("$e") ;; esac
+    else
+        echo "$e: build failed, skipped"
+    fi
+done
+if [ -n "$rev" ]; then
+    if build "$rev" "" "$rev"; then engines+=("${rev//\//_}"); else echo "$rev: build failed, skipped"; fi
+fi
+[ ${#current[@]} -gt 0 ] || exit 1
+
+cases=(testcase/*/*.cm)
+while [ "$(stat -c %s "$dir/speed.cm" 2>/dev/null || echo 0)" -lt $((size * 1048576)) ]; do
+    cat "${cases[@]}" >> "$dir/speed.cm"
+done
+
+echo
+echo "$size MB program, parse time alone, best of $runs, $(nproc) CPUs"
+printf "%-12s %12s %10s %12s\n" engine nodes ms "Mnodes/s"
+for e in "${current[@]}"; do
+    if r=$(speed "$e" "$dir/speed.cm"); then
+        set -- $r
+        awk -v e="$e" -v n="$1" -v ms="$2" 'BEGIN { printf "%-12s %12d %10.2f %12.1f\n", e, n, ms, n / ms / 1e3 }'
+    else
+        printf "%-12s %12s\n" "$e" failed
+    fi
+done
+
+lists="globals params locals statements args"
+echo "void main(void) { }" > "$dir/empty.cm"
+for l in $lists; do
+    for n in $sizes; do program "$l" "$n" > "$dir/$l.$n.cm"; done
+done
+
+first=${sizes%% *}
+last=${sizes##* }
+echo
+echo "ns per list element, best of $runs"
+printf "%-12s %-10s" engine list
+for n in $sizes; do printf " %8s" "$n"; done
+printf " %8s\n" growth
+for e in "${engines[@]}"; do
+    base=$(best "$e" "$dir/empty.cm") || { echo "$e: failed" >&2; continue; }
+    for l in $lists; do
+        printf "%-12s %-10s" "$e" "$l"
+        t= t0=
+        for n in $sizes; do
+            ns=$(best "$e" "$dir/$l.$n.cm") || { printf " %8s" failed; continue; }
+            ns=$((ns > base ? ns - base : 0))
+            awk -v ns="$ns" -v n="$n" 'BEGIN { printf " %8.1f", ns / n }'
+            [ "$n" = "$first" ] && t0=$ns
+            [ "$n" = "$last" ] && t=$ns
+        done
+        if [ -n "$t" ] && [ "${t0:-0}" -gt 0 ] && [ "$last" != "$first" ]; then
+            awk -v t="$t" -v t0="$t0" -v n="$last" -v n0="$first" 'BEGIN { printf " %8.2f\n", t / t0 / (n / n0) }'
+        else
+            printf " %8s\n" -
+        fi
+    done
+done
+
+kinds="parens blocks ifs assigns calls"
+for k in $kinds; do
+    for d in $depths; do nested "$k" "$d" > "$dir/$k.$d.cm"; done
+done
+
+first=${depths%% *}
+last=${depths##* }
+for unit in ns bytes; do
+    echo
+    echo "$unit per nesting level, best of $runs"
+    printf "%-12s %-10s" engine nesting
+    for d in $depths; do printf " %8s" "$d"; done
+    printf " %8s\n" growth
+    for e in yacc descent; do
+        case " ${current[*]} " in *" $e "*) ;; *) continue ;; esac
+        base=$(footprint "$e" "$dir/empty.cm") || { echo "$e: failed" >&2; continue; }
+        set -- $base
+        if [ $unit = ns ]; then base=$1; else base=$2; fi
+        for k in $kinds; do
+            printf "%-12s %-10s" "$e" "$k"
+            v0= v=
+            for d in $depths; do
+                r=$(footprint "$e" "$dir/$k.$d.cm") || { printf " %8s" failed; continue; }
+                set -- $r
+                if [ $unit = ns ]; then
+                    x=$(awk -v ms="$1" -v b="$base" 'BEGIN { x = (ms - b) * 1e6; print (x > 0 ? x : 0) }')
+                else
+                    x=$(( ($2 > base ? $2 - base : 0) * 1024 ))
+                fi
+                awk -v x="$x" -v d="$d" 'BEGIN { printf " %8.1f", x / d }'
+                [ "$d" = "$first" ] && v0=$x
+                [ "$d" = "$last" ] && v=$x
+            done
+            if [ -n "$v" ] && [ -n "$v0" ]; then growth "$v0" "$v" "$first" "$last"; else printf " %8s" -; fi
+            echo
+        done
+    done
+done
@@ -0,0 +1,250 @@
+/****************************************************/
+/* File: parsediff.c                                */
+/* Differential test of the descent parser against  */
+/* the yacc parser (make parsediff)                 */
+/****************************************************/
+
+/* usage: cminus_parsediff file...
+ *
+ * Parses every file with both parsers and compares
+ * the trees field by field (line numbers included)
+ * and everything written to the listing, so syntax
+ * errors must be reported alike too. Then does the
+ * same for every variant of the file made by one
+ * edit of its tokens: each token deleted, doubled,
+ * or swapped with the next one. Most variants are
+ * wrong programs, which tries the error reporting
+ * at every point of the grammar. Prints the first
+ * few differences and a count, and exits nonzero if
+ * there were any
+ */
+
+#include "globals.h"
+#include "util.h"
+#include "parse.h"
+#include "tokbuf.h"
+
+/* MAXREPORTS = differences printed before going quiet */
+#define MAXREPORTS 10
+
+/* allocate global variables */
+int lineno = 0;
+FILE *source;
+FILE *listing;
+FILE *code;
+
+/* allocate and set tracing flags */
+int EchoSource = FALSE;
+int TraceScan = FALSE;
+int BufferTokens = TRUE;
+int BatchLoad = FALSE;
+int DescentParse = FALSE;
+int ParallelParse = FALSE;
+int LazyParse = FALSE;
+int TraceParse = FALSE;
+int TraceAnalyze = FALSE;
+int TraceCode = FALSE;
+
+int Error = FALSE;
+
+static long variants = 0;
+static long differences = 0;
+
+//-----------------
+// One Parse
+//-----------------
+// Struct: Parse Outcome
+typedef struct Outcome
+{
+	TreeNode *tree;
+	char *listed;
+	size_t listedSize;
+	int error;
+	int lineno;
+} Outcome;
+
+// Parse a Copy of text[0..size) with the Parser descent Selects
+static void parseWith(int descent, const char *text, size_t size, Outcome *out)
+{
+	char *copy = (char *)malloc(size + 2);
+	if (copy == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	memcpy(copy, text, size);
+	copy[size] = copy[size + 1] = '\0';
+
+	ParseContext ctx;
+	listing = open_memstream(&out->listed, &out->listedSize);
+	if (listing == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	DescentParse = descent;
+	initParse(&ctx, listing);
+	out->tree = parseText(&ctx, copy, size);
+	out->error = ctx.error;
+	out->lineno = ctx.lineno;
+	fclose(listing);
+	free(copy);
+}
+
+//-----------------
+// Tree Comparison
+//-----------------
+// Describe the First Difference of Trees a and b into why (FALSE If None)
+static int treeDiffers(TreeNode *a, TreeNode *b, char *why, size_t whySize)
+{
+	for (int n = 0; a != NULL || b != NULL; n++, a = a->sibling, b = b->sibling)
+	{
+		if (a == NULL || b == NULL)
+		{
+			snprintf(why, whySize, "sibling %d: %s", n, a == NULL ? "only descent has it" : "only yacc has it");
+			return TRUE;
+		}
+		if (a->kind != b->kind || a->type != b->type || a->val != b->val || a->flag != b->flag ||
+			a->opcode != b->opcode || a->lineno != b->lineno || a->scope != b->scope ||
+			(a->name == NULL) != (b->name == NULL) || (a->name != NULL && strcmp(a->name, b->name) != 0))
+		{
+			snprintf(why, whySize,
+					 "sibling %d: yacc kind 0x%x type 0x%x name %s val %d flag %d opcode %d line %d, "
+					 "descent kind 0x%x type 0x%x name %s val %d flag %d opcode %d line %d",
+					 n, a->kind, a->type, a->name ? a->name : "-", a->val, a->flag, a->opcode, a->lineno, b->kind,
+					 b->type, b->name ? b->name : "-", b->val, b->flag, b->opcode, b->lineno);
+			return TRUE;
+		}
+		for (int i = 0; i < MAXCHILDREN; i++)
+		{
+			char inner[400];
+			if (treeDiffers(a->child[i], b->child[i], inner, sizeof inner))
+			{
+				snprintf(why, whySize, "sibling %d, child %d, %s", n, i, inner);
+				return TRUE;
+			}
+		}
+	}
+	return FALSE;
+}
+
+// Parse text[0..size) Both Ways and Report Any Difference
+static void compareParsers(const char *pgm, const char *variant, const char *text, size_t size)
+{
+	Outcome yacc, descent;
+	char why[512];
+	parseWith(FALSE, text, size, &yacc);
+	parseWith(TRUE, text, size, &descent);
+	variants++;
+
+	why[0] = '\0';
+	if (yacc.error != descent.error) snprintf(why, sizeof why, "Error is %d for yacc, %d for descent", yacc.error, descent.error);
+	else if (yacc.listedSize != descent.listedSize || memcmp(yacc.listed, descent.listed, yacc.listedSize) != 0)
+		snprintf(why, sizeof why, "listing differs:\n--- yacc\n%s--- descent\n%s", yacc.listed, descent.listed);
+	else if (yacc.lineno != descent.lineno)
+		snprintf(why, sizeof why, "lineno is %d for yacc, %d for descent", yacc.lineno, descent.lineno);
+	else
+		treeDiffers(yacc.tree, descent.tree, why, sizeof why);
+	if (why[0] != '\0' && ++differences <= MAXREPORTS) printf("%s, %s: %s\n", pgm, variant, why);
+
+	freeTree(yacc.tree);
+	freeTree(descent.tree);
+	free(yacc.listed);
+	free(descent.listed);
+}
+
+//-----------------
+// Token Edits
+//-----------------
+// Compare the Parsers on text and on Every One-Token Edit of It
+static void compareEdits(const char *pgm, const char *text, size_t size)
+{
+	char *copy = (char *)malloc(size + 2);
+	char *edit = (char *)malloc(2 * size + 4);
+	if (copy == NULL || edit == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	memcpy(copy, text, size);
+	copy[size] = copy[size + 1] = '\0';
+	FILE *quiet = listing = fopen("/dev/null", "w");
+	TokenBuffer *tokens = lexTokenText(copy, size);
+	fclose(quiet);
+	if (tokens == NULL)
+	{
+		fprintf(stderr, "%s: cannot lex\n", pgm);
+		exit(1);
+	}
+
+	compareParsers(pgm, "as is", text, size);
+	// Every Token but ENDFILE
+	for (int i = 0; i < tokens->count - 1; i++)
+	{
+		char variant[64];
+		size_t at = tokens->offset[i], len = tokens->length[i], n;
+
+		// Deleted: Blanked Out, So Lines Stay Where They Were
+		memcpy(edit, text, size);
+		memset(edit + at, ' ', len);
+		snprintf(variant, sizeof variant, "token %d deleted", i);
+		compareParsers(pgm, variant, edit, size);
+
+		// Doubled
+		memcpy(edit, text, at + len);
+		edit[at + len] = ' ';
+		memcpy(edit + at + len + 1, text + at, size - at);
+		snprintf(variant, sizeof variant, "token %d doubled", i);
+		compareParsers(pgm, variant, edit, size + len + 1);
+
+		// Swapped with the Next One (Unless That Is ENDFILE)
+		if (i + 2 < tokens->count)
+		{
+			size_t next = tokens->offset[i + 1], nextLen = tokens->length[i + 1];
+			memcpy(edit, text, at);
+			n = at;
+			memcpy(edit + n, text + next, nextLen);
+			n += nextLen;
+			memcpy(edit + n, text + at + len, next - at - len);
+			n += next - at - len;
+			memcpy(edit + n, text + at, len);
+			n += len;
+			memcpy(edit + n, text + next + nextLen, size - next - nextLen);
+			snprintf(variant, sizeof variant, "tokens %d and %d swapped", i, i + 1);
+			compareParsers(pgm, variant, edit, size);
+		}
+	}
+	freeTokenBuffer(tokens);
+	free(copy);
+	free(edit);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s file...\n", argv[0]);
+		exit(1);
+	}
+	for (int i = 1; i < argc; i++)
+	{
+		size_t size;
+		FILE *file = fopen(argv[i], "r");
+		if (file == NULL)
+		{
+			fprintf(stderr, "File %s not found\n", argv[i]);
+			exit(1);
+		}
+		char *text = readSource(file, &size);
+		fclose(file);
+		if (text == NULL)
+		{
+			fprintf(stderr, "%s: cannot read\n", argv[i]);
+			exit(1);
+		}
+		compareEdits(argv[i], text, size);
+		free(text);
+	}
+	printf("%ld programs parsed both ways, %ld differences\n", variants, differences);
+	return differences == 0 ? 0 : 1;
+}
@@ -0,0 +1,646 @@
+/****************************************************/
+/* File: reparse.c                                  */
+/* Incremental reparsing of top-level declarations  */
+/* for the C-MINUS compiler                         */
+/****************************************************/
+
+#include "reparse.h"
+
+#include <limits.h>
+
+#include "util.h"
+
+/* RELEXWINDOW = bytes past the declarations an edit
+ * touches copied out to be lexed again at first; the
+ * window doubles until the tokens lexed in it meet
+ * the old ones again
+ */
+#define RELEXWINDOW 1024
+
+//-------------
+// Gap Arrays
+//-------------
+// Element i of a
+static void *gapAt(GapArray *a, size_t i) { return a->data + (i < a->before ? i : i + a->capacity - a->count) * a->size; }
+
+// Move the Gap of a to Just before Element i
+static void moveGap(GapArray *a, size_t i)
+{
+	size_t gap = a->capacity - a->count;
+	if (i < a->before) memmove(a->data + (i + gap) * a->size, a->data + i * a->size, (a->before - i) * a->size);
+	else if (i > a->before)
+		memmove(a->data + a->before * a->size, a->data + (a->before + gap) * a->size, (i - a->before) * a->size);
+	a->before = i;
+}
+
+// Make Room in a for count Elements (FALSE If out of Memory)
+static int reserveGap(GapArray *a, size_t count)
+{
+	if (count <= a->capacity) return TRUE;
+	size_t capacity = a->capacity < 16 ? 16 : a->capacity * 2;
+	while (capacity < count) capacity *= 2;
+	char *data = (char *)realloc(a->data, capacity * a->size);
+	if (data == NULL) return FALSE;
+	// The Elements after the Gap Go to the End
+	size_t after = a->count - a->before;
+	memmove(data + (capacity - after) * a->size, data + (a->capacity - after) * a->size, after * a->size);
+	a->data = data;
+	a->capacity = capacity;
+	return TRUE;
+}
+
+// Drop Elements [from, to) of a, Leaving the Gap in Their Place
+static void dropGap(GapArray *a, size_t from, size_t to)
+{
+	moveGap(a, to);
+	a->before = from;
+	a->count -= to - from;
+}
+
+// Put n Elements at the Gap of a, Which Has Room for Them
+static void putGap(GapArray *a, const void *elements, size_t n)
+{
+	memcpy(a->data + a->before * a->size, elements, n * a->size);
+	a->before += n;
+	a->count += n;
+}
+
+//-----------------
+// Segments
+//-----------------
+// Struct: Session Token
+// A token of a segment: its kind (TOKEN2KIND) and the bytes
+// [offset, offset+length) it spans, counted from the segment's start.
+typedef struct SessionToken
+{
+	unsigned int offset;
+	unsigned int length;
+	unsigned char kind;
+} SessionToken;
+
+// Struct: Segment
+// Whole top-level declarations: where their text, tokens and NUMs
+// start and the lines before them, and the declarations parsed from
+// them, first to last along the sibling list of the tree (both NULL if
+// none). A declaration that parsed cleanly has a segment of its own;
+// tokens that did not are kept together in one, with error. A segment
+// starts at its first token and runs to the next one's. The bases of
+// the segments from the cursor on are kept less the totals of the
+// session, so they move with the end of the text. The line numbers of
+// the declarations, and of their lazy bodies, count shown lines before
+// them: those there were when they were parsed or sessionTree last
+// brought them up to date.
+typedef struct Segment
+{
+	DeclarationBase base;
+	TreeNode *first;
+	TreeNode *last;
+	int shown;
+	int error;
+} Segment;
+
+static Segment *segmentAt(ParseSession *session, int k) { return (Segment *)gapAt(&session->segments, k); }
+
+static SessionToken *tokenAt(ParseSession *session, int i) { return (SessionToken *)gapAt(&session->tokens, i); }
+
+// Base of Segment k, Counted from the Start; Segment count Starts at the End of the Text
+static DeclarationBase baseOf(ParseSession *session, int k)
+{
+	DeclarationBase base = {session->lines, session->text.count, (int)session->tokens.count, session->values};
+	if (k == (int)session->segments.count) return base;
+	DeclarationBase *at = &segmentAt(session, k)->base;
+	if (k < session->cursor) return *at;
+	base.line += at->line;
+	base.offset += at->offset;
+	base.token += at->token;
+	base.value += at->value;
+	return base;
+}
+
+// Where Lexing Starts for Segments from first On: Their Base, or the Start of the Text
+static DeclarationBase regionBase(ParseSession *session, int first)
+{
+	DeclarationBase base = {0, 0, 0, 0};
+	return first == 0 ? base : baseOf(session, first);
+}
+
+// Move the Cursor to Segment to, Counting the Bases Crossed from the Other End
+static void moveCursor(ParseSession *session, int to)
+{
+	DeclarationBase end = baseOf(session, session->segments.count);
+	for (; session->cursor < to; session->cursor++)
+	{
+		DeclarationBase *at = &segmentAt(session, session->cursor)->base;
+		at->line += end.line;
+		at->offset += end.offset;
+		at->token += end.token;
+		at->value += end.value;
+	}
+	while (session->cursor > to)
+	{
+		DeclarationBase *at = &segmentAt(session, --session->cursor)->base;
+		at->line -= end.line;
+		at->offset -= end.offset;
+		at->token -= end.token;
+		at->value -= end.value;
+	}
+	moveGap(&session->segments, to);
+}
+
+// Segment Holding Byte pos: the Last Starting at or before It (0 If None Does)
+static int segmentHolding(ParseSession *session, size_t pos)
+{
+	int lo = 0, hi = session->segments.count;
+	while (lo < hi)
+	{
+		int mid = lo + (hi - lo) / 2;
+		if (baseOf(session, mid).offset <= pos) lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo > 0 ? lo - 1 : 0;
+}
+
+// First Declaration of Segments [from, to) (NULL If None)
+static TreeNode *firstOf(ParseSession *session, int from, int to)
+{
+	for (int i = from; i < to; i++)
+		if (segmentAt(session, i)->first != NULL) return segmentAt(session, i)->first;
+	return NULL;
+}
+
+// Last Declaration of Segments [from, to) (NULL If None)
+static TreeNode *lastOf(ParseSession *session, int from, int to)
+{
+	for (int i = to - 1; i >= from; i--)
+		if (segmentAt(session, i)->last != NULL) return segmentAt(session, i)->last;
+	return NULL;
+}
+
+//-----------------
+// Region Lexing
+//-----------------
+// Copy Bytes [from, from+n) of the Text of session as edit Leaves It to out
+static void copyEdited(ParseSession *session, const TextEdit *edit, size_t from, size_t n, char *out)
+{
+	size_t at = from, stop = from + n, editEnd = edit->start + edit->length, k;
+	if (at < edit->start)
+	{
+		k = (stop < edit->start ? stop : edit->start) - at;
+		copySessionText(session, at, k, out);
+		out += k;
+		at += k;
+	}
+	if (at < stop && at < editEnd)
+	{
+		k = (stop < editEnd ? stop : editEnd) - at;
+		memcpy(out, edit->text + (at - edit->start), k);
+		out += k;
+		at += k;
+	}
+	if (at < stop) copySessionText(session, edit->end + (at - editEnd), stop - at, out);
+}
+
+// Struct: Meeting
+// How far the tokens lexed again after an edit are from the old ones:
+// next is the first old segment not yet lexed past, from where lexing
+// started and delta the change in length the edit made.
+typedef struct Meeting
+{
+	ParseSession *session;
+	long delta;
+	size_t from;
+	int next;
+	int met;
+} Meeting;
+
+// Token Met: TRUE If It Is the First Token of Old Segment next, Lexed as It Was, at Its Place Moved by the Edit
+static int meetsOld(TokenType token, size_t offset, size_t length, void *arg)
+{
+	Meeting *m = (Meeting *)arg;
+	ParseSession *session = m->session;
+	size_t at = m->from + offset;
+	for (; m->next < (int)session->segments.count; m->next++)
+	{
+		DeclarationBase base = baseOf(session, m->next);
+		size_t moved = base.offset + m->delta;
+		if (moved < at) continue;
+		if (moved > at || base.token == (int)session->tokens.count) return FALSE;
+		SessionToken *old = tokenAt(session, base.token);
+		m->met = old->kind == TOKEN2KIND(token) && old->length == length;
+		return m->met;
+	}
+	return FALSE;
+}
+
+// Lex the Text as edit Leaves It from Segment first On, until the Old Tokens from Segment lastMin On Are Met (NULL If out of Memory)
+// The tokens are lexed from a copy of a window of the text, which grows
+// while a token might run past its end. Old segment j is met where its
+// first token is lexed as it was, at its old place moved by the edit;
+// *last is then j, or the count of segments if the tokens lexed run to
+// ENDFILE. The buffer's size is that of the text lexed, up to where the
+// tokens met start, and its lines count on from those before it.
+static TokenBuffer *relexRegion(ParseSession *session, const TextEdit *edit, int first, int lastMin, int *last)
+{
+	long delta = (long)edit->length - (long)(edit->end - edit->start);
+	size_t size = session->text.count + delta, end = baseOf(session, lastMin).offset + delta;
+	DeclarationBase from = regionBase(session, first);
+	for (size_t window = end - from.offset + RELEXWINDOW;; window *= 2)
+	{
+		int whole = window >= size - from.offset, cut;
+		if (whole) window = size - from.offset;
+		char *copy = (char *)malloc(window + 2);
+		if (copy == NULL) return NULL;
+		copyEdited(session, edit, from.offset, window, copy);
+		copy[window] = copy[window + 1] = '\0';
+		Meeting meeting = {session, delta, from.offset, lastMin, FALSE};
+		TokenBuffer *lexed = lexTokensUntil(copy, window, whole, meetsOld, &meeting, &cut);
+		if (lexed == NULL)
+		{
+			free(copy);
+			if (cut) continue;
+			return NULL;
+		}
+		lexed->ownsText = TRUE;
+		lexed->size = lexed->offset[lexed->count - 1];
+		lexed->lines.before = from.line;
+		*last = meeting.met ? meeting.next : (int)session->segments.count;
+		return lexed;
+	}
+}
+
+//-----------------
+// Region Parsing
+//-----------------
+// Add a Segment of lexed from Token token, NUM value On to *made (FALSE If out of Memory)
+// Its base is counted from the start of lexed, but for its lines.
+static int addSegment(Segment **made, int *count, int *capacity, TokenBuffer *lexed, int token, int value, TreeNode *first,
+					  TreeNode *last, int error)
+{
+	if (*count == *capacity)
+	{
+		int bigger = *capacity < 16 ? 16 : *capacity * 2;
+		Segment *grown = (Segment *)realloc(*made, bigger * sizeof(Segment));
+		if (grown == NULL) return FALSE;
+		*made = grown;
+		*capacity = bigger;
+	}
+	Segment *segment = &(*made)[(*count)++];
+	segment->base.offset = lexed->offset[token];
+	segment->base.line = LINEOF(&lexed->lines, segment->base.offset) - 1;
+	segment->base.token = token;
+	segment->base.value = value;
+	segment->first = first;
+	segment->last = last;
+	segment->shown = segment->base.line;
+	segment->error = error;
+	return TRUE;
+}
+
+// Count the Declarations among Tokens [start, end) (-1 If Tokens Are Left after the Last)
+// A declaration ends at a SEMI or a closing brace outside all braces.
+static int countDeclarations(TokenBuffer *tokens, int start, int end)
+{
+	int n = 0, depth = 0, last = start;
+	for (int i = start; i < end; i++)
+	{
+		unsigned char kind = tokens->kind[i];
+		if (kind == TOKEN2KIND(LCURLY)) depth++;
+		else if (kind == TOKEN2KIND(RCURLY)) depth--;
+		if (depth != 0 || (kind != TOKEN2KIND(SEMI) && kind != TOKEN2KIND(RCURLY))) continue;
+		n++;
+		last = i + 1;
+	}
+	return last == end ? n : -1;
+}
+
+// Count the Lazy Bodies of a Segment Made of Tokens of lexed up to end from Its Base (FALSE If out of Memory)
+// The lazy bodies are moved onto a copy of the segment's tokens, which
+// outlives lexed and counts from the segment's start too, but for its
+// lines: they count on from those the segment shows.
+static int rebaseSegment(TokenBuffer *lexed, Segment *segment, int end)
+{
+	if (segment->first == NULL) return TRUE;
+	TreeNode *after = segment->last->sibling;
+	TokenBuffer *copy = NULL;
+	for (TreeNode *t = segment->first; t != after; t = t->sibling)
+	{
+		if (t->body == NULL) continue;
+		if (copy == NULL)
+		{
+			if ((copy = copyTokens(lexed, segment->base.token, end, segment->base.value)) == NULL) return FALSE;
+			copy->lines.before = segment->shown;
+		}
+		freeTokenBuffer(t->body->tokens);
+		t->body->tokens = copy;
+		copy->refs++;
+		t->body->start -= segment->base.token;
+		t->body->end -= segment->base.token;
+		t->body->valueStart -= segment->base.value;
+	}
+	freeTokenBuffer(copy);
+	return TRUE;
+}
+
+// Parse the Tokens of lexed as a Program of Its Own, Adding Its Segments to *made (FALSE If out of Memory)
+// One segment per declaration if the parse met no syntax error, else
+// one for them all, whose errors are written to listing. Tokens that
+// are not the whole program are not parsed if there are none.
+static int parseRegion(TokenBuffer *lexed, int whole, FILE *listing, Segment **made, int *count, int *capacity)
+{
+	int end = lexed->count - 1;
+	if (end == 0 && !whole) return TRUE;
+
+	ParseContext ctx;
+	initParse(&ctx, listing);
+	ctx.tokens = lexed;
+	TreeNode *tree = parseInput(&ctx), *last = NULL;
+	int declarations = 0;
+	for (TreeNode *t = tree; t != NULL; t = t->sibling, declarations++) last = t;
+
+	int was = *count, added = TRUE;
+	if (ctx.error || countDeclarations(lexed, 0, end) != declarations)
+		added = addSegment(made, count, capacity, lexed, 0, 0, tree, last, ctx.error);
+	else
+	{
+		int from = 0, depth = 0, values = 0, fromValues = 0;
+		TreeNode *t = tree;
+		for (int i = 0; i < end && added; i++)
+		{
+			unsigned char kind = lexed->kind[i];
+			if (kind == TOKEN2KIND(NUM)) values++;
+			else if (kind == TOKEN2KIND(LCURLY)) depth++;
+			else if (kind == TOKEN2KIND(RCURLY)) depth--;
+			if (depth != 0 || (kind != TOKEN2KIND(SEMI) && kind != TOKEN2KIND(RCURLY))) continue;
+			added = addSegment(made, count, capacity, lexed, from, fromValues, t, t, FALSE);
+			from = i + 1;
+			fromValues = values;
+			t = t->sibling;
+		}
+	}
+	for (int i = was; i < *count && added; i++)
+		added = rebaseSegment(lexed, &(*made)[i], i + 1 < *count ? (*made)[i + 1].base.token : end);
+	if (added) return TRUE;
+	*count = was;
+	freeTree(tree);
+	return FALSE;
+}
+
+// Put the Text of edit, the Tokens of lexed and the Segments made of Them in Place of Segments [first, last) (FALSE If out of Memory)
+// Room is made for all before anything changes, so a failure leaves the
+// session as it was.
+static int commitRegion(ParseSession *session, const TextEdit *edit, TokenBuffer *lexed, int first, int last, Segment *made,
+						int count)
+{
+	DeclarationBase from = regionBase(session, first), to = baseOf(session, last);
+	int tokens = lexed->count - 1, segments = session->segments.count;
+	if (!reserveGap(&session->tokens, session->tokens.count - (to.token - from.token) + tokens) ||
+		!reserveGap(&session->segments, segments - (last - first) + count))
+		return FALSE;
+	TreeNode *before = lastOf(session, 0, first), *gone = firstOf(session, first, last);
+	TreeNode *goneLast = lastOf(session, first, last), *after = firstOf(session, last, segments);
+	for (int i = first; i < last; i++) session->errors -= segmentAt(session, i)->error;
+
+	// The Bases from last On Are Kept from the End, So Nothing after the Edit Moves
+	moveCursor(session, last);
+	dropGap(&session->text, edit->start, edit->end);
+	putGap(&session->text, edit->text, edit->length);
+	dropGap(&session->tokens, from.token, to.token);
+	dropGap(&session->segments, first, last);
+	for (int i = 0; i < count; i++)
+	{
+		Segment segment = made[i];
+		int end = i + 1 < count ? made[i + 1].base.token : tokens;
+		for (int j = segment.base.token; j < end; j++)
+		{
+			SessionToken token = {lexed->offset[j] - segment.base.offset, lexed->length[j], lexed->kind[j]};
+			putGap(&session->tokens, &token, 1);
+		}
+		segment.base.offset += from.offset;
+		segment.base.token += from.token;
+		segment.base.value += from.value;
+		putGap(&session->segments, &segment, 1);
+		session->errors += segment.error;
+	}
+	session->cursor = first + count;
+	session->values += lexed->valueCount - (to.value - from.value);
+	session->lines += LINEOF(&lexed->lines, lexed->size) - 1 - to.line;
+
+	// Drop What Was Parsed from the Old Tokens, and Link What Was Parsed in Its Place
+	if (gone != NULL)
+	{
+		goneLast->sibling = NULL;
+		freeTree(gone);
+	}
+	TreeNode *head = firstOf(session, first, first + count), *tail = lastOf(session, first, first + count);
+	if (head == NULL) head = after;
+	else
+		tail->sibling = after;
+	if (before == NULL) session->tree = head;
+	else
+		before->sibling = head;
+	return TRUE;
+}
+
+// Release the Declarations Parsed into made
+static void freeMade(Segment *made, int count)
+{
+	for (int i = 0; i < count; i++)
+		if (made[i].first != NULL)
+		{
+			// They Are One List, Parsed Together
+			freeTree(made[i].first);
+			return;
+		}
+}
+
+//-----------------
+// Line Numbers
+//-----------------
+// Struct: Line Shift
+// Lines added to the line numbers of the first limit nodes walked.
+typedef struct LineShift
+{
+	int lines;
+	long walked;
+	long limit;
+} LineShift;
+
+static void shiftLine(TreeNode *t, void *arg)
+{
+	LineShift *shift = (LineShift *)arg;
+	if (shift->walked++ < shift->limit) t->lineno += shift->lines;
+}
+
+// Make the Declarations of segment and Their Lazy Bodies Show lines Lines before Them (FALSE If out of Memory, Leaving Them as They Were)
+static int showLines(Segment *segment, int lines)
+{
+	if (segment->first == NULL || segment->shown == lines) return TRUE;
+	TreeNode *after = segment->last->sibling;
+	LineShift shift = {lines - segment->shown, 0, LONG_MAX};
+	segment->last->sibling = NULL;
+	int walked = walkTree(segment->first, shiftLine, NULL, &shift);
+	if (!walked)
+	{
+		// The Walk Is Preorder, So Those Shifted before Memory Ran Out Come First
+		LineShift undo = {-shift.lines, 0, shift.walked};
+		walkTree(segment->first, shiftLine, NULL, &undo);
+	}
+	segment->last->sibling = after;
+	if (!walked) return FALSE;
+	for (TreeNode *t = segment->first; t != after; t = t->sibling)
+		if (t->body != NULL) t->body->tokens->lines.before = lines;
+	segment->shown = lines;
+	return TRUE;
+}
+
+//--------------------------
+// Parse Session Functions
+//--------------------------
+// Lex and Parse a Copy of text[0..size) into a New Session (NULL If out of Memory)
+ParseSession *newParseSession(const char *text, size_t size, FILE *listing)
+{
+	ParseSession *session = (ParseSession *)calloc(1, sizeof(ParseSession));
+	if (session == NULL) return NULL;
+	session->text.size = sizeof(char);
+	session->tokens.size = sizeof(SessionToken);
+	session->segments.size = sizeof(Segment);
+	session->listing = listing;
+	// The Whole Text Put into an Empty Session
+	TextEdit all = {0, 0, text, size};
+	if (!reparse(session, &all))
+	{
+		freeParseSession(session);
+		return NULL;
+	}
+	return session;
+}
+
+// Apply edit to the Text of session and Bring Its Tree up to Date (FALSE If It Cannot)
+int reparse(ParseSession *session, const TextEdit *edit)
+{
+	size_t size = session->text.count;
+	int segments = session->segments.count;
+	if (edit->start > edit->end || edit->end > size ||
+		!reserveGap(&session->text, size - (edit->end - edit->start) + edit->length))
+		return FALSE;
+
+	// Lexed Again from the Segment Holding the Byte before the Edit, Whose
+	// Last Token the Edit May Lengthen, to the One Holding Its End at Least
+	int first = edit->start == 0 ? 0 : segmentHolding(session, edit->start - 1);
+	int last = edit->end >= size ? segments : segmentHolding(session, edit->end) + 1;
+	if (last > segments) last = segments;
+
+	// Parsed Quietly First If Other Declarations Have Errors: If These
+	// Have Too, Segments from the First Error to the Last Are Parsed Again
+	// as One, So an Error Another One Left Open Is Not Taken for Two
+	Segment *made = NULL;
+	int count = 0, capacity = 0;
+	TokenBuffer *lexed;
+	for (;;)
+	{
+		lexed = relexRegion(session, edit, first, last, &last);
+		if (lexed == NULL)
+		{
+			free(made);
+			return FALSE;
+		}
+		int dirty = session->errors, error = FALSE;
+		for (int i = first; i < last; i++) dirty -= segmentAt(session, i)->error;
+		if (!parseRegion(lexed, first == 0 && last == segments, dirty > 0 ? NULL : session->listing, &made, &count,
+						 &capacity))
+		{
+			free(made);
+			freeTokenBuffer(lexed);
+			return FALSE;
+		}
+		for (int i = 0; i < count; i++) error |= made[i].error;
+		if (dirty == 0 || !error) break;
+		freeMade(made, count);
+		freeTokenBuffer(lexed);
+		count = 0;
+		for (int i = 0; i < first; i++)
+			if (segmentAt(session, i)->error)
+			{
+				first = i;
+				break;
+			}
+		for (int i = segments - 1; i >= last; i--)
+			if (segmentAt(session, i)->error)
+			{
+				last = i + 1;
+				break;
+			}
+	}
+
+	int committed = commitRegion(session, edit, lexed, first, last, made, count);
+	if (!committed) freeMade(made, count);
+	free(made);
+	freeTokenBuffer(lexed);
+	return committed;
+}
+
+// Copy Bytes [from, from+n) of the Text of session to out
+void copySessionText(ParseSession *session, size_t from, size_t n, char *out)
+{
+	GapArray *text = &session->text;
+	size_t k = from >= text->before ? 0 : from + n <= text->before ? n : text->before - from;
+	memcpy(out, text->data + from, k);
+	memcpy(out + k, gapAt(text, from + k), n - k);
+}
+
+// Number of Tokens of session, Not Counting ENDFILE
+int sessionTokens(ParseSession *session) { return session->tokens.count; }
+
+// Token i of session, the Bytes It Spans in [*start, *end)
+TokenType sessionToken(ParseSession *session, int i, size_t *start, size_t *end)
+{
+	// The Last Segment Whose Tokens Start at or before i
+	int lo = 0, hi = session->segments.count;
+	while (lo < hi)
+	{
+		int mid = lo + (hi - lo) / 2;
+		if (baseOf(session, mid).token <= i) lo = mid + 1;
+		else
+			hi = mid;
+	}
+	SessionToken *token = tokenAt(session, i);
+	*start = baseOf(session, lo - 1).offset + token->offset;
+	*end = *start + token->length;
+	return KIND2TOKEN(token->kind);
+}
+
+// The Syntax Tree of session with the Line Numbers of the Text as It Is (NULL If out of Memory)
+TreeNode *sessionTree(ParseSession *session)
+{
+	for (int k = 0; k < (int)session->segments.count; k++)
+		if (!showLines(segmentAt(session, k), baseOf(session, k).line)) return NULL;
+	return session->tree;
+}
+
+// Call visit on Each Top-Level Declaration of session, in Order, with Its Base
+void visitDeclarations(ParseSession *session, void (*visit)(TreeNode *, const DeclarationBase *, void *), void *arg)
+{
+	for (int k = 0; k < (int)session->segments.count; k++)
+	{
+		Segment *segment = segmentAt(session, k);
+		DeclarationBase base = baseOf(session, k);
+		base.line -= segment->shown;
+		for (TreeNode *t = segment->first; t != NULL; t = t->sibling)
+		{
+			visit(t, &base, arg);
+			if (t == segment->last) break;
+		}
+	}
+}
+
+// Release Parse Session, Its Tree and Its Tokens
+void freeParseSession(ParseSession *session)
+{
+	if (session == NULL) return;
+	freeTree(session->tree);
+	free(session->text.data);
+	free(session->tokens.data);
+	free(session->segments.data);
+	free(session);
+}
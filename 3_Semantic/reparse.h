@@ -0,0 +1,125 @@
+/****************************************************/
+/* File: reparse.h                                  */
+/* Incremental reparsing of top-level declarations  */
+/* for the C-MINUS compiler                         */
+/****************************************************/
+
+#ifndef _REPARSE_H_
+#define _REPARSE_H_
+
+#include "globals.h"
+#include "parse.h"
+#include "tokbuf.h"
+
+//==================================================================
+// Data Structures for Parse Session
+//==================================================================
+
+// Struct: Text Edit
+// Bytes [start, end) of a text replaced by text[0..length).
+typedef struct TextEdit
+{
+	size_t start;
+	size_t end;
+	const char *text;
+	size_t length;
+} TextEdit;
+
+// Struct: Gap Array
+// count elements of size bytes each, kept in data with a gap of
+// capacity - count free elements after the first before of them, so
+// what is put in or taken out at the gap moves nothing else.
+typedef struct GapArray
+{
+	char *data;
+	size_t size;
+	size_t before;
+	size_t count;
+	size_t capacity;
+} GapArray;
+
+// Struct: Declaration Base
+// Where the text, tokens and NUMs of a top-level declaration start in
+// those of the whole program, and the lines before it. The positions
+// the session keeps of a declaration count from there; see
+// visitDeclarations for its lines.
+typedef struct DeclarationBase
+{
+	int line;
+	size_t offset;
+	int token;
+	int value;
+} DeclarationBase;
+
+// Struct: Parse Session
+// A program kept parsed while it is edited, as an editor does: its
+// text, its tokens and its syntax tree, split by top-level declaration
+// (struct Segment, reparse.c), so an edit is lexed and parsed again
+// only where it falls. The tokens and lazy bodies of a declaration
+// count from its DeclarationBase, and the bases of those after the
+// last edit from the end of the program, so an edit moves none of
+// them. Nor does it renumber the lines of the tree: a declaration
+// keeps those it was parsed with, stale once an edit above it adds or
+// removes a line. So tree is not for the passes after parsing
+// (buildSymtab, typeCheck, printTree): sessionTree is. text.count is
+// the size of the text; errors counts the runs of declarations whose
+// tokens have a syntax error.
+typedef struct ParseSession
+{
+	TreeNode *tree;
+	GapArray text;
+	GapArray tokens;
+	GapArray segments;
+	// Segments before the Last Edit, Whose Bases Count from the Start
+	int cursor;
+	// NUMs and Newlines of the Whole Text
+	int values;
+	int lines;
+	int errors;
+	// Syntax Errors Are Written to listing (Only Counted If NULL)
+	FILE *listing;
+} ParseSession;
+
+//==================================================================
+// Parse Session Functions
+//==================================================================
+
+// Lex and Parse a Copy of text[0..size) into a New Session (NULL If out of Memory)
+// The parse is an ordinary one, with the engine DescentParse selects.
+ParseSession *newParseSession(const char *text, size_t size, FILE *listing);
+// Apply edit to the Text of session and Bring Its Tree up to Date (FALSE If It Cannot)
+// Lexing starts at the top-level declaration before the edit and stops
+// at the first declaration after it whose first token is lexed as it
+// was; only the declarations between are parsed again, as a program of
+// their own, and their subtrees take the place of the old ones in the
+// list of declarations. The others keep their subtrees and positions.
+// Declarations whose tokens have a syntax error are kept together,
+// parsed again as one at the next edit touching them; their errors are
+// those a parse of them alone reports, so an error running past them
+// (a brace left open) is met at the token after them. edit->text must
+// not point into the session. An edit out of the text, or running out
+// of memory, leaves the session as it was.
+int reparse(ParseSession *session, const TextEdit *edit);
+// Copy Bytes [from, from+n) of the Text of session to out
+void copySessionText(ParseSession *session, size_t from, size_t n, char *out);
+// Number of Tokens of session, Not Counting ENDFILE
+int sessionTokens(ParseSession *session);
+// Token i of session, the Bytes It Spans in [*start, *end)
+TokenType sessionToken(ParseSession *session, int i, size_t *start, size_t *end);
+// The Syntax Tree of session with the Line Numbers of the Text as It Is (NULL If out of Memory)
+// The declarations whose lines moved since they were parsed, or since
+// the last call, are walked to renumber them, and so are the lines of
+// their lazy bodies when parsed later; the others are not. Until the
+// next reparse the tree can go to the passes after parsing. Running
+// out of memory leaves the declarations not yet renumbered as they
+// were, for a later call to renumber.
+TreeNode *sessionTree(ParseSession *session);
+// Call visit on Each Top-Level Declaration of session, in Order, with Its Base
+// The tokens of its lazy body count from base, and the line numbers of
+// its subtree and of the body once parsed count from base.line, the
+// lines before it not yet counted into them: 0 after sessionTree.
+void visitDeclarations(ParseSession *session, void (*visit)(TreeNode *, const DeclarationBase *, void *), void *arg);
+// Release Parse Session, Its Tree and Its Tokens
+void freeParseSession(ParseSession *session);
+
+#endif
@@ -0,0 +1,467 @@
+/****************************************************/
+/* File: reparsebench.c                             */
+/* Check and benchmark of reparsing after an edit   */
+/* (make reparsebench)                              */
+/****************************************************/
+
+/* usage: cminus_reparse_bench file...
+ *
+ * Keeps every file parsed in a session (reparse.h)
+ * through a run of random edits: tokens and text
+ * deleted, put in or changed, lines and comments
+ * added, half of the edits undone by the next one.
+ * After each one the text is compared with a copy
+ * edited apart, and the tree field by field (line
+ * numbers and lazy bodies included, counted from the
+ * base of each declaration) with that of a fresh
+ * parse of the whole text, which must fail
+ * if and only if the session has a syntax error. Every
+ * other time a file is taken afresh, the lines are
+ * instead those sessionTree gives, counted from the
+ * start, and a random quarter of the lazy bodies left
+ * are parsed at each edit, as are those of the fresh
+ * parse the session has parsed. This
+ * is done for both parsers, eager and lazy. Then
+ * times a fresh parse against reparsing after small
+ * edits in the middle of generated programs of ever
+ * more functions: the reparse should not grow with
+ * them. Exits nonzero on any difference
+ */
+
+#include <time.h>
+
+#include "globals.h"
+#include "util.h"
+#include "parse.h"
+#include "tokbuf.h"
+#include "reparse.h"
+
+/* EDITS = random edits made to each file per parser
+ * RESTART = edits after which a file is taken afresh
+ * MAXREPORTS = differences printed before going quiet
+ */
+#define EDITS 400
+#define RESTART 40
+#define MAXREPORTS 10
+
+/* allocate global variables */
+int lineno = 0;
+FILE *source;
+FILE *listing;
+FILE *code;
+
+/* allocate and set tracing flags */
+int EchoSource = FALSE;
+int TraceScan = FALSE;
+int BufferTokens = TRUE;
+int BatchLoad = FALSE;
+int DescentParse = FALSE;
+int ParallelParse = FALSE;
+int LazyParse = FALSE;
+int TraceParse = FALSE;
+int TraceAnalyze = FALSE;
+int TraceCode = FALSE;
+
+int Error = FALSE;
+
+static long edits = 0;
+static long differences = 0;
+static unsigned long seed = 1;
+
+static unsigned int randomBelow(unsigned int n)
+{
+	seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+	return (unsigned int)(seed >> 33) % n;
+}
+
+static void *allocate(size_t size)
+{
+	void *p = malloc(size);
+	if (p == NULL)
+	{
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	return p;
+}
+
+//-----------------
+// Tree Comparison
+//-----------------
+static int listDiffers(TreeNode *a, TreeNode *b, const DeclarationBase *base, char *why, size_t whySize);
+
+// Bytes of a Prefix snprintf Wrote into whySize, the Rest Going on after It
+static size_t written(int k, size_t whySize) { return k < 0 ? 0 : (size_t)k < whySize ? (size_t)k : whySize - 1; }
+
+// Describe the First Difference of Node a, Its Positions Counted from base, and Node b into why (FALSE If None)
+static int nodeDiffers(TreeNode *a, TreeNode *b, const DeclarationBase *base, char *why, size_t whySize)
+{
+	if (a->kind != b->kind || a->type != b->type || a->val != b->val || a->flag != b->flag || a->opcode != b->opcode ||
+		a->lineno + base->line != b->lineno || a->scope != b->scope || (a->name == NULL) != (b->name == NULL) ||
+		(a->name != NULL && strcmp(a->name, b->name) != 0))
+	{
+		snprintf(why, whySize,
+				 "session kind 0x%x type 0x%x name %s val %d flag %d opcode %d line %d, "
+				 "fresh kind 0x%x type 0x%x name %s val %d flag %d opcode %d line %d",
+				 a->kind, a->type, a->name ? a->name : "-", a->val, a->flag, a->opcode, a->lineno + base->line, b->kind,
+				 b->type, b->name ? b->name : "-", b->val, b->flag, b->opcode, b->lineno);
+		return TRUE;
+	}
+	// Lazy Bodies: the Same Tokens, Each of Its Own Buffer
+	if ((a->body == NULL) != (b->body == NULL) ||
+		(a->body != NULL &&
+		 (a->body->start + base->token != b->body->start || a->body->end + base->token != b->body->end ||
+		  a->body->valueStart + base->value != b->body->valueStart)))
+	{
+		snprintf(why, whySize, "lazy bodies differ");
+		return TRUE;
+	}
+	for (int i = 0; i < MAXCHILDREN; i++)
+	{
+		size_t k = written(snprintf(why, whySize, "child %d, ", i), whySize);
+		if (listDiffers(a->child[i], b->child[i], base, why + k, whySize - k)) return TRUE;
+	}
+	return FALSE;
+}
+
+// Describe the First Difference of Lists a, Its Positions Counted from base, and b into why (FALSE If None)
+static int listDiffers(TreeNode *a, TreeNode *b, const DeclarationBase *base, char *why, size_t whySize)
+{
+	for (int n = 0; a != NULL || b != NULL; n++, a = a->sibling, b = b->sibling)
+	{
+		size_t k = written(snprintf(why, whySize, "sibling %d: ", n), whySize);
+		if (a == NULL || b == NULL)
+		{
+			snprintf(why + k, whySize - k, "%s", a == NULL ? "only the fresh parse has it" : "only the session has it");
+			return TRUE;
+		}
+		if (nodeDiffers(a, b, base, why + k, whySize - k)) return TRUE;
+	}
+	return FALSE;
+}
+
+// Struct: Comparison
+// A walk of the declarations of a session alongside those of a fresh
+// parse: fresh is the next one, n its index, why the first difference.
+// If numbered, the session's lines are taken as they are. A body with
+// a syntax error is dropped, on either side, and compared as missing
+// (bodyError only takes the flag functionBody sets).
+typedef struct Comparison
+{
+	TreeNode *fresh;
+	int n;
+	int numbered;
+	char *why;
+	size_t whySize;
+	int bodyError;
+} Comparison;
+
+static void compareDeclaration(TreeNode *t, const DeclarationBase *base, void *arg)
+{
+	Comparison *c = (Comparison *)arg;
+	DeclarationBase at = *base;
+	if (c->numbered) at.line = 0;
+	// A Body the Session Has Parsed Is Compared Parsed
+	if (c->fresh != NULL && t->body == NULL && c->fresh->body != NULL) functionBody(c->fresh, NULL, &c->bodyError);
+	if (c->why[0] == '\0')
+	{
+		size_t k = written(snprintf(c->why, c->whySize, "declaration %d: ", c->n), c->whySize);
+		if (c->fresh == NULL) snprintf(c->why + k, c->whySize - k, "only the session has it");
+		else if (!nodeDiffers(t, c->fresh, &at, c->why + k, c->whySize - k))
+			c->why[0] = '\0';
+	}
+	if (c->fresh != NULL) c->fresh = c->fresh->sibling;
+	c->n++;
+}
+
+// Compare the Session with a Fresh Parse of Its Text, and Its Text with expect[0..expectSize), Reporting Any Difference
+// If numbered, the lines compared are those of sessionTree.
+static void compareFresh(const char *pgm, const char *edit, ParseSession *session, const char *expect, size_t expectSize,
+						 int numbered)
+{
+	size_t size = session->text.count;
+	char *copy = (char *)allocate(size + 2);
+	char why[512];
+	copySessionText(session, 0, size, copy);
+	copy[size] = copy[size + 1] = '\0';
+	// Checked before the Parse Writes to copy
+	int textDiffers = size != expectSize || memcmp(copy, expect, size) != 0;
+	ParseContext ctx;
+	initParse(&ctx, NULL);
+	TreeNode *tree = parseText(&ctx, copy, size);
+	edits++;
+
+	why[0] = '\0';
+	if (textDiffers) snprintf(why, sizeof why, "text differs from the edits made");
+	else if (ctx.error != (session->errors > 0))
+		snprintf(why, sizeof why, "syntax error %s the fresh parse only", ctx.error ? "in" : "missing from");
+	else if (!ctx.error)
+	{
+		Comparison c = {tree, 0, numbered, why, sizeof why, FALSE};
+		if (numbered)
+		{
+			TreeNode *numberedTree = sessionTree(session);
+			if (numberedTree == NULL)
+			{
+				fprintf(stderr, "Out of memory\n");
+				exit(1);
+			}
+			// A Quarter of the Bodies Parsed Now, the Rest after Later Edits, from the Lines sessionTree Gave
+			for (TreeNode *t = numberedTree; t != NULL; t = t->sibling)
+				if (t->body != NULL && randomBelow(4) == 0) functionBody(t, NULL, &c.bodyError);
+		}
+		visitDeclarations(session, compareDeclaration, &c);
+		if (why[0] == '\0' && c.fresh != NULL) snprintf(why, sizeof why, "declaration %d: only the fresh parse has it", c.n);
+	}
+	if (why[0] != '\0' && ++differences <= MAXREPORTS)
+		printf("%s, edit %ld (%s, descent %d, lazy %d): %s\n", pgm, edits, edit, DescentParse, LazyParse, why);
+	freeTree(tree);
+	free(copy);
+}
+
+//-----------------
+// Random Edits
+//-----------------
+/* Pieces put into the text: whole tokens and
+ * declarations, and what only moves lines or opens
+ * and closes a comment
+ */
+static const char *pieces[] = {
+	" ", "\n", "\n\n", "/* x */", "/*", "*/", "{", "}", ";", "(", ")", "[", "]", "=", "==", "<", "+", "-", "*", ",",
+	"x", "i", "input", "0", "1", "42", "int", "void", "if", "else", "while", "return", "int x;\n", "int y[10];",
+	"x = x + 1;", "return 0;", "if (x) x = 1; else x = 2;", "while (x < 10) { x = x + 1; }",
+	"void f(void) { }\n", "int g(int a, int b[]) { return a; }\n", "{ int z; z = 1; }",
+};
+
+// Make a Random Edit of the Text of session into *edit, and Describe It into what
+static void randomEdit(ParseSession *session, TextEdit *edit, char *what, size_t whatSize)
+{
+	size_t size = session->text.count;
+	char c;
+	edit->start = size == 0 ? 0 : randomBelow(size + 1);
+	edit->end = edit->start;
+	edit->text = "";
+	edit->length = 0;
+	switch (randomBelow(4))
+	{
+	case 0:
+		// Bytes Deleted
+		edit->end += randomBelow(size - edit->start < 12 ? size - edit->start + 1 : 12);
+		break;
+	case 1:
+		// A Piece Put In
+		edit->text = pieces[randomBelow(sizeof pieces / sizeof pieces[0])];
+		edit->length = strlen(edit->text);
+		break;
+	case 2:
+		// A Token Replaced by a Piece
+		if (sessionTokens(session) > 0)
+			sessionToken(session, randomBelow(sessionTokens(session)), &edit->start, &edit->end);
+		edit->text = pieces[randomBelow(sizeof pieces / sizeof pieces[0])];
+		edit->length = strlen(edit->text);
+		break;
+	default:
+		// A Line Broken, or Joined with the Next
+		if (edit->start < size && (copySessionText(session, edit->start, 1, &c), c == '\n')) edit->end++;
+		else
+		{
+			edit->text = "\n";
+			edit->length = 1;
+		}
+		break;
+	}
+	snprintf(what, whatSize, "[%zu, %zu) to \"%.*s\"", edit->start, edit->end, (int)edit->length, edit->text);
+}
+
+// Text[0..*size) as edit Leaves It, the Old Text Released
+static char *applyEdit(char *text, size_t *size, const TextEdit *edit)
+{
+	size_t edited = *size - (edit->end - edit->start) + edit->length;
+	char *copy = (char *)allocate(edited + 1);
+	memcpy(copy, text, edit->start);
+	memcpy(copy + edit->start, edit->text, edit->length);
+	memcpy(copy + edit->start + edit->length, text + edit->end, *size - edit->end);
+	free(text);
+	*size = edited;
+	return copy;
+}
+
+// Keep text Parsed in a Session through EDITS Random Edits, Comparing Each with a Fresh Parse
+static void checkEdits(const char *pgm, const char *text, size_t size)
+{
+	ParseSession *session = NULL;
+	// The Text Edited Apart from the Session
+	char *expect = NULL;
+	size_t expectSize = 0;
+	int numbered = FALSE;
+	for (int n = 0; n < EDITS; n++)
+	{
+		if (n % RESTART == 0)
+		{
+			numbered = !numbered;
+			freeParseSession(session);
+			free(expect);
+			expect = (char *)allocate(size + 1);
+			memcpy(expect, text, size);
+			expectSize = size;
+			session = newParseSession(text, size, NULL);
+			if (session == NULL)
+			{
+				fprintf(stderr, "Out of memory\n");
+				exit(1);
+			}
+			compareFresh(pgm, "as is", session, expect, expectSize, numbered);
+		}
+
+		TextEdit edit, undo;
+		char what[128];
+		randomEdit(session, &edit, what, sizeof what);
+		// The Bytes Replaced, to Undo It
+		size_t replaced = edit.end - edit.start;
+		char *old = (char *)allocate(replaced + 1);
+		copySessionText(session, edit.start, replaced, old);
+		if (!reparse(session, &edit))
+		{
+			fprintf(stderr, "%s: reparse failed\n", pgm);
+			exit(1);
+		}
+		expect = applyEdit(expect, &expectSize, &edit);
+		compareFresh(pgm, what, session, expect, expectSize, numbered);
+		if (randomBelow(2) == 0)
+		{
+			undo.start = edit.start;
+			undo.end = edit.start + edit.length;
+			undo.text = old;
+			undo.length = replaced;
+			if (!reparse(session, &undo))
+			{
+				fprintf(stderr, "%s: reparse failed\n", pgm);
+				exit(1);
+			}
+			expect = applyEdit(expect, &expectSize, &undo);
+			compareFresh(pgm, "undone", session, expect, expectSize, numbered);
+		}
+		free(old);
+	}
+	freeParseSession(session);
+	free(expect);
+}
+
+//-----------------
+// Timing
+//-----------------
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Text of a Program of n Functions, Its Size in *size
+static char *generate(int n, size_t *size)
+{
+	char *text = (char *)allocate((size_t)n * 160 + 64);
+	size_t at = 0;
+	for (int i = 0; i < n; i++)
+		at += sprintf(text + at,
+					  "int f%d(int a, int b[])\n{\n\tint x;\n\tx = a + %d;\n\twhile (x > 0)\n\t{\n\t\tx = x - b[1];\n\t}\n"
+					  "\treturn x;\n}\n",
+					  i, i % 100);
+	at += sprintf(text + at, "void main(void) { }\n");
+	*size = at;
+	return text;
+}
+
+// Seconds per reparse, Edit and Undo Taking Turns
+// The gaps of the session are first moved to the edit, untimed: the
+// first edit far from the last one moves them across the text between.
+static double timeEdit(ParseSession *session, TextEdit *edit, TextEdit *undo)
+{
+	int reps = 200;
+	if (!reparse(session, edit) || !reparse(session, undo))
+	{
+		fprintf(stderr, "reparse failed\n");
+		exit(1);
+	}
+	double start = now();
+	for (int i = 0; i < reps; i++)
+		if (!reparse(session, edit) || !reparse(session, undo))
+		{
+			fprintf(stderr, "reparse failed\n");
+			exit(1);
+		}
+	return (now() - start) / (2 * reps);
+}
+
+// Time a Fresh Parse against Reparsing after an Edit in the Middle Function
+static void timeSizes(void)
+{
+	printf("%9s %9s %6s %12s %12s %12s %12s\n", "functions", "bytes", "lazy", "fresh ms", "digit us", "newline us",
+		   "function us");
+	for (int n = 1000; n <= 64000; n *= 4)
+		for (LazyParse = FALSE; LazyParse <= TRUE; LazyParse++)
+		{
+			size_t size;
+			char *text = generate(n, &size);
+			double start = now();
+			ParseSession *session = newParseSession(text, size, NULL);
+			double fresh = now() - start;
+			if (session == NULL || session->errors > 0)
+			{
+				fprintf(stderr, "generated program does not parse\n");
+				exit(1);
+			}
+
+			// The Number Added in the Middle Function, a Line Break before It, a Function after It
+			char *middle = strstr(text, "x = a + ");
+			for (int i = 0; i < n / 2; i++) middle = strstr(middle + 1, "x = a + ");
+			size_t at = middle - text + strlen("x = a + ");
+			TextEdit digit = {at, at + 1, "7", 1}, digitBack = {at, at + 1, text + at, 1};
+			TextEdit line = {at, at, "\n", 1}, lineBack = {at, at + 1, "", 0};
+			size_t end = strstr(middle, "return x;\n}\n") - text + strlen("return x;\n}\n");
+			const char *fn = "int g(void) { return 0; }\n";
+			TextEdit added = {end, end, fn, strlen(fn)}, addedBack = {end, end + strlen(fn), "", 0};
+			double d = timeEdit(session, &digit, &digitBack);
+			double l = timeEdit(session, &line, &lineBack);
+			double f = timeEdit(session, &added, &addedBack);
+			printf("%9d %9zu %6d %12.2f %12.1f %12.1f %12.1f\n", n, size, LazyParse, fresh * 1e3, d * 1e6, l * 1e6, f * 1e6);
+			freeParseSession(session);
+			free(text);
+		}
+	LazyParse = FALSE;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s file...\n", argv[0]);
+		exit(1);
+	}
+	listing = fopen("/dev/null", "w");
+	for (int i = 1; i < argc; i++)
+	{
+		size_t size;
+		FILE *file = fopen(argv[i], "r");
+		if (file == NULL)
+		{
+			fprintf(stderr, "File %s not found\n", argv[i]);
+			exit(1);
+		}
+		char *text = readSource(file, &size);
+		fclose(file);
+		if (text == NULL)
+		{
+			fprintf(stderr, "%s: cannot read\n", argv[i]);
+			exit(1);
+		}
+		for (DescentParse = FALSE; DescentParse <= TRUE; DescentParse++)
+			for (LazyParse = FALSE; LazyParse <= TRUE; LazyParse++) checkEdits(argv[i], text, size);
+		free(text);
+	}
+	printf("%ld edits reparsed, %ld differences\n", edits, differences);
+
+	DescentParse = TRUE;
+	timeSizes();
+	return differences == 0 ? 0 : 1;
+}
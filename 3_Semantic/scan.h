@@ -9,16 +9,65 @@
 #define _SCAN_H_
 
 #include "globals.h"
+#include "lines.h"
 
 /* MAXTOKENLEN is the maximum size of a token */
 #define MAXTOKENLEN 40
 
-/* tokenString array stores the lexeme of each token */
-extern char tokenString[MAXTOKENLEN + 1];
+/* ScanContext holds everything one scan owns, so
+ * several files can be lexed at once (each on its
+ * own thread if need be): the reentrant flex
+ * scanner, the source text and the last token.
+ * Tokens carry offsets only; tokenLine turns one
+ * into a line number through a newline index made
+ * with the context, before flex has written any of
+ * its NUL terminators into the text
+ */
+typedef struct ScanContext
+{
+	// Flex Scanner (a yyscan_t)
+	void *scanner;
+	// Lexeme of the Last Token: a View into the Scan Buffer,
+	// Not NUL-Terminated, Valid until the Next Token
+	const char *tokenString;
+	unsigned int tokenLength;
+	// Value of the Last NUM Token
+	int tokenValue;
+	// Source Text and Position of the Lexeme in It
+	const char *text;
+	size_t size;
+	unsigned int tokenOffset;
+	// Where ENDFILE Was Met (size, or Where a Comment Ran Out)
+	unsigned int endOffset;
+	// Source Read by newScanner (Owned by the Context)
+	char *buffer;
+	// Newline Index of text
+	LineIndex lines;
+} ScanContext;
+
+/* Function newScanner reads all of file and returns
+ * a context that lexes it, or NULL if out of memory
+ */
+ScanContext *newScanner(FILE *file);
+
+/* Function newBufferScanner returns a context that
+ * lexes text[0..size) in place; text must be followed
+ * by two NUL bytes and outlive the context, and is
+ * written to while it is lexed
+ */
+ScanContext *newBufferScanner(char *text, size_t size);
+
+/* Procedure freeScanner releases a scan context */
+void freeScanner(ScanContext *scan);
 
 /* function getToken returns the
- * next token in source file
+ * next token of the scan
+ */
+TokenType getToken(ScanContext *scan);
+
+/* Function tokenLine returns the line number of the
+ * last token of the scan
  */
-TokenType getToken(void);
+int tokenLine(ScanContext *scan);
 
 #endif
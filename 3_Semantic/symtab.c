@@ -17,70 +17,84 @@
 //----------------
 // Hash Functions
 //----------------
-#define SHIFT 4
-static int hash(char *key)
-{
-	int temp = 0;
-	int i = 0;
-	while (key[i] != '\0')
-	{
-		temp = ((temp << SHIFT) + key[i]) % SIZE;
-		++i;
-	}
-	return temp;
-}
+// Names Are Atoms, Which Carry Their Hash
+#if ATOMHASHMOD % SIZE != 0
+#error "ATOMHASHMOD must be a multiple of SIZE"
+#endif
+#define hash(name) ((int)(ATOMHASH(name) % SIZE))
 
 //--------------------------------------------------------
 // Scope Tables (each entries containes its symbol table)
 //--------------------------------------------------------
 static ScopeList scopeList = NULL;
+// Last Scope, Where the Next One Is Appended
+static ScopeRec *lastScope = NULL;
+
+// Names of Numbered Scopes Are Built Here, Only When Printed
+static char *nameBuffer = NULL;
+static size_t nameCapacity = 0;
+
+// Get Scope Name: Its Own, or Its Parent's Followed by Its Number (Empty If out of Memory)
+// A scope nested d deep has a name d numbers long, so building one
+// for every new scope made deep nesting quadratic; only a listing
+// builds them now, and it prints each name whole anyway.
+static const char *scopeName(ScopeRec *scope)
+{
+	// Get Name Length
+	char digits[16];
+	size_t length = 0;
+	ScopeRec *named = scope;
+	for (; named->name == NULL; named = named->parent) length += 1 + snprintf(digits, sizeof(digits), "%d", named->number);
+	size_t namedLength = strlen(named->name);
+	length += namedLength;
+	if (length + 1 > nameCapacity)
+	{
+		char *bigger = (char *)realloc(nameBuffer, length + 1);
+		if (bigger == NULL) return "";
+		nameBuffer = bigger;
+		nameCapacity = length + 1;
+	}
+
+	// Fill Name from Its End
+	char *end = nameBuffer + length;
+	*end = '\0';
+	for (ScopeRec *numbered = scope; numbered != named; numbered = numbered->parent)
+	{
+		int count = snprintf(digits, sizeof(digits), "%d", numbered->number);
+		end -= count;
+		memcpy(end, digits, count);
+		*--end = '.';
+	}
+	memcpy(nameBuffer, named->name, namedLength);
+	return nameBuffer;
+}
 
 //--------------------------------------------------------
 // Symbol & Scope Table Functions
 //--------------------------------------------------------
 // Insert New Scope
-ScopeRec *insertScope(char *name, ScopeRec *parent, TreeNode *func)
+ScopeRec *insertScope(const char *name, ScopeRec *parent, TreeNode *func)
 {
 	// Error Check: Parameters
 	ERROR_CHECK( name != NULL || parent != NULL );
 
-	// Get Scope Name: Given or Derived
-	char *scopeName = NULL;
-	if (name == NULL)
-	{
-		size_t length = strlen(parent->name);
-		scopeName = (char *)malloc(sizeof(char) * (length + 6));
-		snprintf(scopeName, length + 6, "%s.%d", parent->name, parent->numScopes++);
-		scopeName[length + 5] = '\0';
-	}
+	// Get Scope Name: Given, or Numbered under Parent
+	char *ownName = NULL;
+	int number = 0;
+	if (name == NULL) number = parent->numScopes++;
 	else
 	{
 		size_t length = strlen(name);
-		scopeName = (char *)malloc(sizeof(char) * (length + 1));
-		memcpy(scopeName, name, length);
-		scopeName[length] = '\0';
-	}
-
-	// Get Last Index of Scope
-	int redefined = (parent != NULL && parent->state == STATE_REDEFINED) ? TRUE : FALSE;
-	ScopeRec *lastScope = scopeList;
-	while (lastScope != NULL)
-	{
-		// Error Check: Already Defined Scope is Exist with Redefinition Flags
-		if (strcmp(scopeName, lastScope->name) == 0)
-		{
-			ERROR_CHECK(lastScope->state == STATE_REDEFINED );
-			redefined = TRUE;
-		}
-		// Iterate Scope List
-		if (lastScope->next == NULL) break;
-		lastScope = lastScope->next;
+		ownName = (char *)malloc(sizeof(char) * (length + 1));
+		memcpy(ownName, name, length);
+		ownName[length] = '\0';
 	}
 
-	// Add New Scope to Scope HashTable
+	// Add New Scope to Scope HashTable (Scopes in a Redefined Function Are Redefined Too)
 	ScopeRec *scope = (ScopeRec *)malloc(sizeof(ScopeRec));
-	scope->name = scopeName;
-	scope->state = redefined == TRUE ? STATE_REDEFINED : STATE_NORMAL;
+	scope->name = ownName;
+	scope->number = number;
+	scope->state = (parent != NULL && parent->state == STATE_REDEFINED) ? STATE_REDEFINED : STATE_NORMAL;
 	scope->func = func;
 	for (int i = 0; i < SIZE; ++i) scope->symbolList[i] = NULL;
 	scope->numSymbols = 0;
@@ -89,6 +103,7 @@ ScopeRec *insertScope(char *name, ScopeRec *parent, TreeNode *func)
 	if (lastScope == NULL) scopeList = scope;
 	else
 		lastScope->next = scope;
+	lastScope = scope;
 	scope->next = NULL;
 
 	// Return
@@ -97,7 +112,7 @@ ScopeRec *insertScope(char *name, ScopeRec *parent, TreeNode *func)
 
 
 // Insert New Symbol
-SymbolRec *insertSymbol(ScopeRec *currentScope, char *name, NodeType type, SymbolKind kind, int lineno, TreeNode *node)
+SymbolRec *insertSymbol(ScopeRec *currentScope, Atom name, NodeType type, SymbolKind kind, int lineno, TreeNode *node)
 {
 	// Error Check: Parameters
 	ERROR_CHECK( currentScope != NULL && name != NULL );
@@ -109,7 +124,7 @@ SymbolRec *insertSymbol(ScopeRec *currentScope, char *name, NodeType type, Symbo
 	while (lastSymbol != NULL)
 	{
 		// If Duplicated Symbol Exist
-		if( strcmp(name, lastSymbol->name) == 0 )
+		if (name == lastSymbol->name)
 		{
 			if (lastSymbol->state == STATE_REDEFINED) state = STATE_REDEFINED;
 			else if( lastSymbol->state == STATE_UNDECLARED)
@@ -148,7 +163,7 @@ SymbolRec *insertSymbol(ScopeRec *currentScope, char *name, NodeType type, Symbo
 }
 
 // Add Use to Exist Symbol
-SymbolRec *appendSymbol(ScopeRec *currentScope, char *name, int lineno)
+SymbolRec *appendSymbol(ScopeRec *currentScope, Atom name, int lineno)
 {
 	// Error Check: Parameters
 	ERROR_CHECK( currentScope != NULL && name != NULL );
@@ -160,7 +175,7 @@ SymbolRec *appendSymbol(ScopeRec *currentScope, char *name, int lineno)
 	while (scope != NULL)
 	{
 		symbol = scope->symbolList[hashIdx];
-		while ((symbol != NULL) && (strcmp(name, symbol->name) != 0)) symbol = symbol->next;
+		while ((symbol != NULL) && (name != symbol->name)) symbol = symbol->next;
 
 		// If Find, Break, Else, Goto Parent Scope
 		if (symbol == NULL) scope = scope->parent;
@@ -182,8 +197,41 @@ SymbolRec *appendSymbol(ScopeRec *currentScope, char *name, int lineno)
 	return symbol;
 }
 
+// Release All Scopes & Symbols (for a Next Program to Start Anew)
+void freeSymbolTable(void)
+{
+	while (scopeList != NULL)
+	{
+		ScopeRec *scope = scopeList;
+		for (int i = 0; i < SIZE; ++i)
+		{
+			SymbolRec *symbol = scope->symbolList[i];
+			while (symbol != NULL)
+			{
+				SymbolRec *nextSymbol = symbol->next;
+				LineListRec *line = symbol->lineList;
+				while (line != NULL)
+				{
+					LineListRec *nextLine = line->next;
+					free(line);
+					line = nextLine;
+				}
+				free(symbol);
+				symbol = nextSymbol;
+			}
+		}
+		scopeList = scope->next;
+		free(scope->name);
+		free(scope);
+	}
+	lastScope = NULL;
+	free(nameBuffer);
+	nameBuffer = NULL;
+	nameCapacity = 0;
+}
+
 // Search symbolList with Name
-SymbolRec *lookupSymbol(ScopeRec *currentScope, char *name)
+SymbolRec *lookupSymbol(ScopeRec *currentScope, Atom name)
 {
 	// Error Check: Parameters
 	ERROR_CHECK( currentScope != NULL && name != NULL );
@@ -196,7 +244,7 @@ SymbolRec *lookupSymbol(ScopeRec *currentScope, char *name)
 	while (scope != NULL)
 	{
 		symbol = scope->symbolList[hashIdx];
-		while ((symbol != NULL) && (strcmp(name, symbol->name) != 0)) symbol = symbol->next;
+		while ((symbol != NULL) && (name != symbol->name)) symbol = symbol->next;
 
 		// If Find, Return, Else, Goto Parent Scope
 		if (symbol == NULL) scope = scope->parent;
@@ -208,7 +256,7 @@ SymbolRec *lookupSymbol(ScopeRec *currentScope, char *name)
 	return NULL;
 }
 
-SymbolRec *lookupSymbolInCurrentScope(ScopeRec *currentScope, char *name)
+SymbolRec *lookupSymbolInCurrentScope(ScopeRec *currentScope, Atom name)
 {
 	// Error Check: Parameters
 	ERROR_CHECK( currentScope != NULL && name != NULL );
@@ -217,12 +265,12 @@ SymbolRec *lookupSymbolInCurrentScope(ScopeRec *currentScope, char *name)
 	int hashIdx = hash(name);
 	ScopeRec *scope = currentScope;
 	SymbolRec *symbol = scope->symbolList[hashIdx];
-	while ((symbol != NULL) && (strcmp(name, symbol->name) != 0)) symbol = symbol->next;
+	while ((symbol != NULL) && (name != symbol->name)) symbol = symbol->next;
 
 	return symbol;
 }
 
-SymbolRec *lookupSymbolWithKind(ScopeRec *currentScope, char *name, SymbolKind kind)
+SymbolRec *lookupSymbolWithKind(ScopeRec *currentScope, Atom name, SymbolKind kind)
 {
 	// Error Check: Parameters
 	ERROR_CHECK( currentScope != NULL && name != NULL );
@@ -235,7 +283,7 @@ SymbolRec *lookupSymbolWithKind(ScopeRec *currentScope, char *name, SymbolKind k
 	while (scope != NULL)
 	{
 		symbol = scope->symbolList[hashIdx];
-		while ((symbol != NULL) && ((strcmp(name, symbol->name) != 0) || (symbol->kind != kind))) symbol = symbol->next;
+		while ((symbol != NULL) && ((name != symbol->name) || (symbol->kind != kind))) symbol = symbol->next;
 
 		// If Find, Return, Else, Goto Parent Scope
 		if (symbol == NULL) scope = scope->parent;
@@ -265,7 +313,7 @@ void printSymbolTable(FILE *listing)
 						symbol->name,
 						KIND2STR(symbol->kind),
 						TYPE2STR(symbol->type),
-						scope->name,
+						scopeName(scope),
 						symbol->memloc);
 				// Line Numbers
 				LineListRec *line = symbol->lineList;
@@ -372,7 +420,7 @@ void printScope(FILE *listing, ScopeRec *globalScope)
 				scope = currentScope;
 
 				// Scope Name, Nested Level, Symbol Name, Symbol Type
-				fprintf(listing, "%-12s  %-12d  %-13s  %-11s\n", scope->name, nested_level, symbol->name, TYPE2STR(symbol->type));
+				fprintf(listing, "%-12s  %-12d  %-13s  %-11s\n", scopeName(scope), nested_level, symbol->name, TYPE2STR(symbol->type));
 				PrintSymbol = TRUE;
 
 				// Iterate
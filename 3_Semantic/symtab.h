@@ -10,6 +10,7 @@
 #define _SYMTAB_H_
 
 #include "globals.h"
+#include "intern.h"
 
 /* SIZE is the size of the hash table */
 #define SIZE 211
@@ -39,7 +40,7 @@ typedef struct LineListRec
 typedef struct SymbolRec
 {
 	// Attributes: Name, Error, Type, Kind, Line, Memory Location, Node
-	char *name;
+	Atom name;
 	SemanticErrorState state;
 	NodeType type;
 	SymbolKind kind;
@@ -53,8 +54,9 @@ typedef struct SymbolRec
 // Struct: Scope
 typedef struct ScopeRec
 {
-	// Attributes: Name, Function Node
+	// Attributes: Name (NULL If Numbered under Parent), Number, Function Node
 	char *name;
+	int number;
 	SemanticErrorState state;
 	TreeNode *func;
 	// Symbol Tables in This Scope
@@ -71,18 +73,20 @@ typedef struct ScopeRec
 //==================================================================
 
 // Insert New Scope
-ScopeRec *insertScope(char *name, ScopeRec *parent, TreeNode *func);
+ScopeRec *insertScope(const char *name, ScopeRec *parent, TreeNode *func);
 // Search Scope with Name
 // ScopeRec *lookupScope(char *name, ScopeRec *parent);
 
 // Insert New Symbol
-SymbolRec *insertSymbol(ScopeRec *currentScope, char *name, NodeType type, SymbolKind kind, int lineno, TreeNode *node);
+SymbolRec *insertSymbol(ScopeRec *currentScope, Atom name, NodeType type, SymbolKind kind, int lineno, TreeNode *node);
 // Add Use to Exist Symbol
-SymbolRec *appendSymbol(ScopeRec *currentScope, char *name, int lineno);
+SymbolRec *appendSymbol(ScopeRec *currentScope, Atom name, int lineno);
+// Release All Scopes & Symbols (for a Next Program to Start Anew)
+void freeSymbolTable(void);
 // Search symbolList with Name (and Scope, Kind)
-SymbolRec *lookupSymbol(ScopeRec *currentScope, char *name);
-SymbolRec *lookupSymbolInCurrentScope(ScopeRec *currentScope, char *name);
-SymbolRec *lookupSymbolWithKind(ScopeRec *currentScope, char *name, SymbolKind kind);
+SymbolRec *lookupSymbol(ScopeRec *currentScope, Atom name);
+SymbolRec *lookupSymbolInCurrentScope(ScopeRec *currentScope, Atom name);
+SymbolRec *lookupSymbolWithKind(ScopeRec *currentScope, Atom name, SymbolKind kind);
 
 // Print Symbol & Scope Tables
 void printSymbolTable(FILE *listing);
@@ -0,0 +1,328 @@
+/****************************************************/
+/* File: tokbuf.c                                   */
+/* Token buffer implementation for the C-MINUS      */
+/* compiler                                         */
+/****************************************************/
+
+#include "tokbuf.h"
+
+#include "globals.h"
+#include "scan.h"
+#include "util.h"
+
+/* INITTOKENS = initial capacity of a token buffer */
+#define INITTOKENS 1024
+
+//----------------------
+// Token Array Handling
+//----------------------
+// Make Room for count Tokens
+static int reserveTokens(TokenBuffer *tokens, int count)
+{
+	if (count <= tokens->capacity) return TRUE;
+	int capacity = tokens->capacity * 2;
+	while (capacity < count) capacity *= 2;
+	unsigned char *kind = (unsigned char *)realloc(tokens->kind, capacity * sizeof(unsigned char));
+	if (kind != NULL) tokens->kind = kind;
+	unsigned int *offset = (unsigned int *)realloc(tokens->offset, capacity * sizeof(unsigned int));
+	if (offset != NULL) tokens->offset = offset;
+	unsigned int *length = (unsigned int *)realloc(tokens->length, capacity * sizeof(unsigned int));
+	if (length != NULL) tokens->length = length;
+	if (kind == NULL || offset == NULL || length == NULL) return FALSE;
+	tokens->capacity = capacity;
+	return TRUE;
+}
+
+// Make Room for count NUM Values
+static int reserveValues(TokenBuffer *tokens, int count)
+{
+	if (count <= tokens->valueCapacity) return TRUE;
+	int capacity = tokens->valueCapacity * 2;
+	while (capacity < count) capacity *= 2;
+	int *value = (int *)realloc(tokens->value, capacity * sizeof(int));
+	if (value == NULL) return FALSE;
+	tokens->value = value;
+	tokens->valueCapacity = capacity;
+	return TRUE;
+}
+
+static int appendToken(TokenBuffer *tokens, TokenType token, ScanContext *scan)
+{
+	if (!reserveTokens(tokens, tokens->count + 1)) return FALSE;
+	if (token == NUM)
+	{
+		if (!reserveValues(tokens, tokens->valueCount + 1)) return FALSE;
+		tokens->value[tokens->valueCount++] = scan->tokenValue;
+	}
+	tokens->kind[tokens->count] = TOKEN2KIND(token);
+	tokens->offset[tokens->count] = scan->tokenOffset;
+	tokens->length[tokens->count] = scan->tokenLength;
+	tokens->count++;
+	return TRUE;
+}
+
+//------------------------
+// Token Buffer Functions
+//------------------------
+// Read All of File and Lex It into a New Token Buffer (NULL on Failure)
+TokenBuffer *lexTokenBuffer(FILE *file)
+{
+	size_t size;
+	char *text = readSource(file, &size);
+	if (text == NULL)
+	{
+		fprintf(listing, ferror(file) ? "Read error at line 0\n" : "Out of memory error at line 0\n");
+		return NULL;
+	}
+	TokenBuffer *tokens = lexTokenText(text, size);
+	if (tokens == NULL)
+	{
+		free(text);
+		return NULL;
+	}
+	tokens->ownsText = TRUE;
+	return tokens;
+}
+
+// New Empty Token Buffer on text[0..size), with Room for capacity Tokens (NULL If out of Memory)
+static TokenBuffer *newTokenBuffer(char *text, size_t size, int capacity)
+{
+	TokenBuffer *tokens = (TokenBuffer *)malloc(sizeof(TokenBuffer));
+	if (tokens == NULL) return NULL;
+	tokens->text = text;
+	tokens->size = size;
+	tokens->ownsText = FALSE;
+	tokens->kind = (unsigned char *)malloc(capacity * sizeof(unsigned char));
+	tokens->offset = (unsigned int *)malloc(capacity * sizeof(unsigned int));
+	tokens->length = (unsigned int *)malloc(capacity * sizeof(unsigned int));
+	tokens->value = (int *)malloc(capacity * sizeof(int));
+	tokens->count = 0;
+	tokens->capacity = capacity;
+	tokens->valueCount = 0;
+	tokens->valueCapacity = capacity;
+	tokens->pos = 0;
+	tokens->valuePos = 0;
+	tokens->tokenString = "";
+	tokens->tokenLength = 0;
+	tokens->tokenValue = 0;
+	tokens->tokenLine = 0;
+	tokens->lines.nl = NULL;
+	tokens->refs = 1;
+	if (tokens->kind == NULL || tokens->offset == NULL || tokens->length == NULL || tokens->value == NULL)
+	{
+		freeTokenBuffer(tokens);
+		return NULL;
+	}
+	return tokens;
+}
+
+// Lex text[0..size), Followed by Two NULs, into a New Token Buffer That Borrows It (NULL on Failure)
+TokenBuffer *lexTokenText(char *text, size_t size)
+{
+	TokenBuffer *tokens = newTokenBuffer(text, size, INITTOKENS);
+	// Lex Whole Translation Unit on a Scanner of Its Own
+	ScanContext *scan = tokens != NULL ? newBufferScanner(tokens->text, tokens->size) : NULL;
+	if (scan == NULL)
+	{
+		fprintf(listing, "Out of memory error at line 0\n");
+		freeTokenBuffer(tokens);
+		return NULL;
+	}
+	TokenType token;
+	do
+	{
+		token = getToken(scan);
+		if (!appendToken(tokens, token, scan))
+		{
+			fprintf(listing, "Out of memory error at line %d\n", tokenLine(scan));
+			freeScanner(scan);
+			freeTokenBuffer(tokens);
+			return NULL;
+		}
+	} while (token != ENDFILE);
+	// Keep the Scanner's Newline Index, Made before Lexing Changed text
+	tokens->lines = scan->lines;
+	scan->lines.nl = NULL;
+	freeScanner(scan);
+
+	return tokens;
+}
+
+// Hand Out the Token at the Cursor as getToken Would (Its Lexeme, Value and Line Kept in tokens)
+TokenType nextToken(TokenBuffer *tokens)
+{
+	int i = tokens->pos;
+	// Stay on ENDFILE Once Reached
+	if (i < tokens->count - 1) tokens->pos++;
+
+	TokenType token = KIND2TOKEN(tokens->kind[i]);
+	// Lexeme Is a View into the Buffered Source; No Copy
+	tokens->tokenString = tokens->text + tokens->offset[i];
+	tokens->tokenLength = tokens->length[i];
+	if (token == NUM) tokens->tokenValue = tokens->value[tokens->valuePos++];
+	tokens->tokenLine = LINEOF(&tokens->lines, tokens->offset[i]);
+	return token;
+}
+
+// Drop a Hold on Token Buffer, Releasing It (and Its Source Text If It Owns It) with the Last
+void freeTokenBuffer(TokenBuffer *tokens)
+{
+	if (tokens == NULL || --tokens->refs > 0) return;
+	free(tokens->kind);
+	free(tokens->offset);
+	free(tokens->length);
+	freeLineIndex(&tokens->lines);
+	free(tokens->value);
+	if (tokens->ownsText) free(tokens->text);
+	free(tokens);
+}
+
+//-------------------------
+// Token Ranges and Views
+//-------------------------
+// Index of the RCURLY Matching the LCURLY at open (-1 If None), and the NUMs from One to the Other in *values
+int matchBrace(TokenBuffer *tokens, int open, int *values)
+{
+	int depth = 0, nums = 0;
+	for (int i = open; i < tokens->count - 1; i++)
+	{
+		unsigned char kind = tokens->kind[i];
+		if (kind == TOKEN2KIND(NUM)) nums++;
+		else if (kind == TOKEN2KIND(LCURLY)) depth++;
+		else if (kind == TOKEN2KIND(RCURLY) && --depth == 0)
+		{
+			*values = nums;
+			return i;
+		}
+	}
+	return -1;
+}
+
+// New Range of Tokens [start, end) Holding tokens (NULL If out of Memory)
+TokenRange *newTokenRange(TokenBuffer *tokens, int start, int end, int valueStart)
+{
+	TokenRange *range = (TokenRange *)malloc(sizeof(TokenRange));
+	if (range == NULL) return NULL;
+	range->tokens = tokens;
+	range->start = start;
+	range->end = end;
+	range->valueStart = valueStart;
+	tokens->refs++;
+	return range;
+}
+
+// Release Token Range and Its Hold on the Buffer
+void freeTokenRange(TokenRange *range)
+{
+	if (range == NULL) return;
+	freeTokenBuffer(range->tokens);
+	free(range);
+}
+
+// Make view a Buffer of Tokens [start, end) of tokens, Then ENDFILE (FALSE If out of Memory)
+int viewTokens(TokenBuffer *tokens, int start, int end, int valueStart, TokenBuffer *view)
+{
+	int length = end - start;
+	*view = *tokens;
+	view->kind = (unsigned char *)malloc(length + 1);
+	if (view->kind == NULL) return FALSE;
+	memcpy(view->kind, tokens->kind + start, length);
+	view->kind[length] = TOKEN2KIND(ENDFILE);
+	// Offsets and Lengths Go on to the Token at end, Where ENDFILE Is Said to Be
+	view->offset = tokens->offset + start;
+	view->length = tokens->length + start;
+	view->count = length + 1;
+	view->value = tokens->value + valueStart;
+	view->pos = 0;
+	view->valuePos = 0;
+	view->ownsText = FALSE;
+	return TRUE;
+}
+
+// Release What viewTokens Allocated for view
+void freeTokenView(TokenBuffer *view) { free(view->kind); }
+
+//--------------------------
+// Partial Lexes and Copies
+//--------------------------
+// Lex text[0..size), Followed by Two NULs, into a New Token Buffer That Borrows It, up to a Token met Accepts (NULL on Failure)
+TokenBuffer *lexTokensUntil(char *text, size_t size, int whole, TokenMet met, void *arg, int *cut)
+{
+	*cut = FALSE;
+	TokenBuffer *tokens = newTokenBuffer(text, size, INITTOKENS);
+	ScanContext *scan = tokens != NULL ? newBufferScanner(text, size) : NULL;
+	if (scan == NULL)
+	{
+		freeTokenBuffer(tokens);
+		return NULL;
+	}
+	TokenType token;
+	int failed = FALSE;
+	do
+	{
+		token = getToken(scan);
+		// A Token at the End of the Window May Go on past It
+		if (!whole && (token == ENDFILE || scan->tokenOffset + scan->tokenLength >= size))
+		{
+			*cut = TRUE;
+			break;
+		}
+		if (token != ENDFILE && met(token, scan->tokenOffset, scan->tokenLength, arg))
+		{
+			// ENDFILE Said to Be Where the Token Met Is
+			token = ENDFILE;
+			scan->tokenLength = 0;
+		}
+		failed = !appendToken(tokens, token, scan);
+	} while (token != ENDFILE && !failed);
+	if (failed || *cut)
+	{
+		freeScanner(scan);
+		freeTokenBuffer(tokens);
+		return NULL;
+	}
+	tokens->lines = scan->lines;
+	scan->lines.nl = NULL;
+	freeScanner(scan);
+	return tokens;
+}
+
+// Count the NUMs among Tokens [start, end)
+static int countValues(TokenBuffer *tokens, int start, int end)
+{
+	int n = 0;
+	for (int i = start; i < end; i++) n += tokens->kind[i] == TOKEN2KIND(NUM);
+	return n;
+}
+
+// New Buffer of a Copy of Tokens [start, end) of tokens and of Their Text, Then ENDFILE (NULL If out of Memory)
+TokenBuffer *copyTokens(TokenBuffer *tokens, int start, int end, int valueStart)
+{
+	size_t from = tokens->offset[start], size = tokens->offset[end] - from;
+	int count = end - start, values = countValues(tokens, start, end);
+	char *text = (char *)malloc(size + 2);
+	TokenBuffer *copy = text != NULL ? newTokenBuffer(text, size, count + 1) : NULL;
+	if (copy == NULL)
+	{
+		free(text);
+		return NULL;
+	}
+	copy->ownsText = TRUE;
+	memcpy(text, tokens->text + from, size);
+	text[size] = text[size + 1] = '\0';
+	if (!buildLineIndex(&copy->lines, text, size))
+	{
+		freeTokenBuffer(copy);
+		return NULL;
+	}
+	memcpy(copy->kind, tokens->kind + start, count * sizeof(unsigned char));
+	memcpy(copy->length, tokens->length + start, count * sizeof(unsigned int));
+	for (int i = 0; i < count; i++) copy->offset[i] = tokens->offset[start + i] - from;
+	memcpy(copy->value, tokens->value + valueStart, values * sizeof(int));
+	copy->kind[count] = TOKEN2KIND(ENDFILE);
+	copy->offset[count] = size;
+	copy->length[count] = 0;
+	copy->count = count + 1;
+	copy->valueCount = values;
+	return copy;
+}
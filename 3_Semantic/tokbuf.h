@@ -0,0 +1,115 @@
+/****************************************************/
+/* File: tokbuf.h                                   */
+/* Token buffer interface for the C-MINUS compiler  */
+/* (a whole translation unit lexed up front)        */
+/****************************************************/
+
+#ifndef _TOKBUF_H_
+#define _TOKBUF_H_
+
+#include "globals.h"
+#include "lines.h"
+
+/* Yacc/Bison numbers tokens upward from TOKENBASE,
+ * so every token fits in one byte as an offset
+ * from it; kind 0 is ENDFILE
+ */
+#define TOKENBASE 256
+#define TOKEN2KIND(tok) ((unsigned char)((tok) == ENDFILE ? 0 : (tok) - TOKENBASE))
+#define KIND2TOKEN(kind) ((kind) == 0 ? ENDFILE : (TokenType)(kind) + TOKENBASE)
+
+//==================================================================
+// Data Structures for Token Buffer
+//==================================================================
+
+// Struct: Token Buffer
+// Token i is (kind[i], offset[i], length[i]); its lexeme is
+// text[offset[i] .. offset[i]+length[i]). The values of the NUM
+// tokens are kept apart in value[], in token order. Lines are not
+// stored: nextToken finds them from the offsets through the newline
+// index the scanner made of text. The last token is always ENDFILE.
+typedef struct TokenBuffer
+{
+	// Token Attributes (parallel arrays)
+	unsigned char *kind;
+	unsigned int *offset;
+	unsigned int *length;
+	int count;
+	int capacity;
+	// NUM Token Values
+	int *value;
+	int valueCount;
+	int valueCapacity;
+	// Source Text (NUL padded; freed with the buffer if ownsText)
+	char *text;
+	size_t size;
+	int ownsText;
+	// Cursors of nextToken
+	int pos;
+	int valuePos;
+	// Last Token Handed Out by nextToken, as a ScanContext Keeps It:
+	// Lexeme (a View into text), Value If a NUM, and Line
+	const char *tokenString;
+	unsigned int tokenLength;
+	int tokenValue;
+	int tokenLine;
+	// Newline Index of text
+	LineIndex lines;
+	// Holders: Whoever Lexed It, and Each TokenRange on It
+	int refs;
+} TokenBuffer;
+
+// Struct: Token Range
+// Tokens [start, end) of a buffer, valueStart the index into value[]
+// of their first NUM. A range keeps its buffer (and so the source
+// text, which must outlive it if borrowed) alive until it is freed.
+typedef struct TokenRange
+{
+	TokenBuffer *tokens;
+	int start;
+	int end;
+	int valueStart;
+} TokenRange;
+
+// Token Met: TRUE to Stop Lexing at the Token Lexed at Bytes [offset, offset+length)
+typedef int (*TokenMet)(TokenType token, size_t offset, size_t length, void *arg);
+
+//==================================================================
+// Token Buffer Functions
+//==================================================================
+
+// Read All of File and Lex It into a New Token Buffer (NULL on Failure, Reported to listing)
+// The file is read to its end unless memory runs out first.
+TokenBuffer *lexTokenBuffer(FILE *file);
+// Lex text[0..size), Followed by Two NULs, into a New Token Buffer That Borrows It (NULL on Failure, Reported to listing)
+// The text is written to while it is lexed, and must outlive the buffer.
+TokenBuffer *lexTokenText(char *text, size_t size);
+// Hand Out the Token at the Cursor as getToken Would (Its Lexeme, Value and Line Kept in tokens)
+TokenType nextToken(TokenBuffer *tokens);
+// Drop a Hold on Token Buffer, Releasing It (and Its Source Text If It Owns It) with the Last
+void freeTokenBuffer(TokenBuffer *tokens);
+// Index of the RCURLY Matching the LCURLY at open (-1 If None), and the NUMs from One to the Other in *values
+int matchBrace(TokenBuffer *tokens, int open, int *values);
+// New Range of Tokens [start, end) Holding tokens (NULL If out of Memory)
+TokenRange *newTokenRange(TokenBuffer *tokens, int start, int end, int valueStart);
+// Release Token Range and Its Hold on the Buffer
+void freeTokenRange(TokenRange *range);
+// Make view a Buffer of Tokens [start, end) of tokens, Then ENDFILE (FALSE If out of Memory)
+// The view shares everything with tokens but a copy of the kinds, since
+// the kind after end is not ENDFILE; freeTokenView releases that copy
+// alone, and tokens must outlive the view.
+int viewTokens(TokenBuffer *tokens, int start, int end, int valueStart, TokenBuffer *view);
+// Release What viewTokens Allocated for view
+void freeTokenView(TokenBuffer *view);
+// Lex text[0..size), Followed by Two NULs, into a New Token Buffer That Borrows It, up to a Token met Accepts (NULL on Failure)
+// That token is left out and ENDFILE put at its offset; with no such
+// token the buffer ends at the ENDFILE of the text. Unless whole, the
+// text is a window cut out of a longer one, so a token reaching its
+// end may go on past it: *cut is then set, and no buffer made.
+TokenBuffer *lexTokensUntil(char *text, size_t size, int whole, TokenMet met, void *arg, int *cut);
+// New Buffer of a Copy of Tokens [start, end) of tokens and of Their Text, Then ENDFILE (NULL If out of Memory)
+// The text copied runs from the first token to the token at end, and
+// offsets and lines are counted from its start; the copy owns it.
+TokenBuffer *copyTokens(TokenBuffer *tokens, int start, int end, int valueStart);
+
+#endif
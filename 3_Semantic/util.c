@@ -8,12 +8,15 @@
 
 #include "util.h"
 
+#include <sys/stat.h>
+
 #include "globals.h"
+#include "tokbuf.h"
 
-/* Procedure printToken prints a token
- * and its lexeme to the listing file
+/* Procedure fprintToken prints a token
+ * and its lexeme to out
  */
-void printToken(TokenType token, const char *tokenString)
+void fprintToken(FILE *out, TokenType token, const char *tokenString, int tokenLength)
 {
 	switch (token)
 	{
@@ -22,35 +25,43 @@ void printToken(TokenType token, const char *tokenString)
 		case WHILE:
 		case RETURN:
 		case INT:
-		case VOID: fprintf(listing, "reserved word: %s\n", tokenString); break;
-		case ASSIGN: fprintf(listing, "=\n"); break;
-		case EQ: fprintf(listing, "==\n"); break;
-		case NE: fprintf(listing, "!=\n"); break;
-		case LT: fprintf(listing, "<\n"); break;
-		case LE: fprintf(listing, "<=\n"); break;
-		case GT: fprintf(listing, ">\n"); break;
-		case GE: fprintf(listing, ">=\n"); break;
-		case PLUS: fprintf(listing, "+\n"); break;
-		case MINUS: fprintf(listing, "-\n"); break;
-		case TIMES: fprintf(listing, "*\n"); break;
-		case OVER: fprintf(listing, "/\n"); break;
-		case LPAREN: fprintf(listing, "(\n"); break;
-		case RPAREN: fprintf(listing, ")\n"); break;
-		case LBRACE: fprintf(listing, "[\n"); break;
-		case RBRACE: fprintf(listing, "]\n"); break;
-		case LCURLY: fprintf(listing, "{\n"); break;
-		case RCURLY: fprintf(listing, "}\n"); break;
-		case SEMI: fprintf(listing, ";\n"); break;
-		case COMMA: fprintf(listing, ",\n"); break;
-		case ENDFILE: fprintf(listing, "EOF\n"); break;
-
-		case NUM: fprintf(listing, "NUM, val= %s\n", tokenString); break;
-		case ID: fprintf(listing, "ID, name= %s\n", tokenString); break;
-		case ERROR: fprintf(listing, "ERROR: %s\n", tokenString); break;
-		default: /* should never happen */ fprintf(listing, "Unknown token: %d\n", token);
+		case VOID: fprintf(out, "reserved word: %.*s\n", tokenLength, tokenString); break;
+		case ASSIGN: fprintf(out, "=\n"); break;
+		case EQ: fprintf(out, "==\n"); break;
+		case NE: fprintf(out, "!=\n"); break;
+		case LT: fprintf(out, "<\n"); break;
+		case LE: fprintf(out, "<=\n"); break;
+		case GT: fprintf(out, ">\n"); break;
+		case GE: fprintf(out, ">=\n"); break;
+		case PLUS: fprintf(out, "+\n"); break;
+		case MINUS: fprintf(out, "-\n"); break;
+		case TIMES: fprintf(out, "*\n"); break;
+		case OVER: fprintf(out, "/\n"); break;
+		case LPAREN: fprintf(out, "(\n"); break;
+		case RPAREN: fprintf(out, ")\n"); break;
+		case LBRACE: fprintf(out, "[\n"); break;
+		case RBRACE: fprintf(out, "]\n"); break;
+		case LCURLY: fprintf(out, "{\n"); break;
+		case RCURLY: fprintf(out, "}\n"); break;
+		case SEMI: fprintf(out, ";\n"); break;
+		case COMMA: fprintf(out, ",\n"); break;
+		case ENDFILE: fprintf(out, "EOF\n"); break;
+
+		case NUM: fprintf(out, "NUM, val= %.*s\n", tokenLength, tokenString); break;
+		case ID: fprintf(out, "ID, name= %.*s\n", tokenLength, tokenString); break;
+		case ERROR: fprintf(out, "ERROR: %.*s\n", tokenLength, tokenString); break;
+		default: /* should never happen */ fprintf(out, "Unknown token: %d\n", token);
 	}
 }
 
+/* Procedure printToken prints a token
+ * and its lexeme to the listing file
+ */
+void printToken(TokenType token, const char *tokenString, int tokenLength)
+{
+	fprintToken(listing, token, tokenString, tokenLength);
+}
+
 /* Function newStmtNode creates a new statement
  * node for syntax tree construction
  */
@@ -78,6 +89,7 @@ TreeNode *newTreeNode(NodeKind kind)
 	t->opcode = -1;
 
 	t->scope = NULL;
+	t->body = NULL;
 
 	return t;
 }
@@ -98,6 +110,131 @@ char *copyString(char *s)
 	return t;
 }
 
+/* Function readSource reads all of file into one
+ * heap buffer, followed by the two NUL bytes the
+ * scanner needs to lex it in place. Returns NULL
+ * if out of memory or on a read error
+ */
+char *readSource(FILE *file, size_t *size)
+{
+	struct stat st;
+	size_t capacity = 65536, length = 0, n;
+	if (fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) capacity = (size_t)st.st_size + 1;
+
+	char *text = (char *)malloc(capacity + 2);
+	if (text == NULL) return NULL;
+	while ((n = fread(text + length, 1, capacity - length, file)) > 0)
+	{
+		length += n;
+		if (length == capacity)
+		{
+			char *bigger = (char *)realloc(text, capacity * 2 + 2);
+			if (bigger == NULL)
+			{
+				free(text);
+				return NULL;
+			}
+			text = bigger;
+			capacity *= 2;
+		}
+	}
+	if (ferror(file))
+	{
+		free(text);
+		return NULL;
+	}
+	text[length] = text[length + 1] = '\0';
+	*size = length;
+	return text;
+}
+
+/* A WalkFrame is a node on the way down a walk and
+ * the next of its children to visit, -1 before
+ * preProc has been called on it
+ */
+typedef struct WalkFrame
+{
+	TreeNode *node;
+	int child;
+} WalkFrame;
+
+int walkTree(TreeNode *tree, void (*preProc)(TreeNode *, void *), void (*postProc)(TreeNode *, void *), void *arg)
+{
+	int capacity = 64, count = 1;
+	WalkFrame *stack = (WalkFrame *)malloc(capacity * sizeof(WalkFrame));
+	if (stack == NULL) return FALSE;
+	stack[0].node = tree;
+	stack[0].child = -1;
+	while (count > 0)
+	{
+		WalkFrame *frame = &stack[count - 1];
+		TreeNode *t = frame->node;
+		if (t == NULL)
+		{
+			count--;
+			continue;
+		}
+		if (frame->child < 0)
+		{
+			if (preProc != NULL) preProc(t, arg);
+			frame->child = 0;
+		}
+		if (frame->child < MAXCHILDREN)
+		{
+			TreeNode *child = t->child[frame->child++];
+			if (child == NULL) continue;
+			if (count == capacity)
+			{
+				WalkFrame *grown = (WalkFrame *)realloc(stack, capacity * 2 * sizeof(WalkFrame));
+				if (grown == NULL)
+				{
+					free(stack);
+					return FALSE;
+				}
+				stack = grown;
+				capacity *= 2;
+			}
+			stack[count].node = child;
+			stack[count].child = -1;
+			count++;
+			continue;
+		}
+		// subtrees done: the frame moves on to the next sibling
+		frame->node = t->sibling;
+		frame->child = -1;
+		if (postProc != NULL) postProc(t, arg);
+	}
+	free(stack);
+	return TRUE;
+}
+
+/* procedure freeTree releases a syntax tree,
+ * its siblings and all their subtrees
+ */
+void freeTree(TreeNode *tree)
+{
+	/* the nodes still to free are one list through
+	 * sibling: the children of a node are spliced in
+	 * ahead of the rest as it is freed, so no stack is
+	 * taken however deep the tree is
+	 */
+	while (tree != NULL)
+	{
+		TreeNode *rest = tree->sibling;
+		for (int i = MAXCHILDREN - 1; i >= 0; i--)
+		{
+			TreeNode *child = tree->child[i], *last = child;
+			if (child == NULL) continue;
+			while (last->sibling != NULL) last = last->sibling;
+			last->sibling = rest;
+			rest = child;
+		}
+		freeTokenRange(tree->body);
+		free(tree);
+		tree = rest;
+	}
+}
+
 /* Variable indentno is used by printTree to
  * store current number of spaces to indent
  */
@@ -114,50 +251,68 @@ static void printSpaces(void)
 	for (i = 0; i < indentno; i++) fprintf(listing, " ");
 }
 
-/* procedure printTree prints a syntax tree to the
- * listing file using indentation to indicate subtrees
+/* printNode prints one node of a syntax tree,
+ * indented by its depth
  */
-void printTree(TreeNode *tree)
+static void printNode(TreeNode *tree, void *arg)
 {
-	int i;
+	(void)arg;
 	INDENT;
-	while (tree != NULL)
+	printSpaces();
+	switch (tree->kind)
 	{
-		printSpaces();
-		switch (tree->kind)
-		{
-			case VariableDecl: fprintf(listing, "Variable Declaration: name = %s, type = %s\n", tree->name, TYPE2STR(tree->type)); break;
-			case FunctionDecl: fprintf(listing, "Function Declaration: name = %s, return type = %s\n", tree->name, TYPE2STR(tree->type)); break;
-			case Params:
-				if (tree->flag == TRUE) fprintf(listing, "Void Parameter\n");
-				else
-					fprintf(listing, "Parameter: name = %s, type = %s\n", tree->name, TYPE2STR(tree->type));
-				break;
-			case CompoundStmt: fprintf(listing, "Compound Statement:\n"); break;
-			case IfStmt:
-				if (tree->flag == TRUE) fprintf(listing, "If-Else Statement:\n");
-				else
-					fprintf(listing, "If Statement:\n");
-				break;
-			case WhileStmt: fprintf(listing, "While Statement:\n"); break;
-			case ReturnStmt:
-				if (tree->flag == TRUE) fprintf(listing, "Non-value Return Statement\n");
-				else
-					fprintf(listing, "Return Statement:\n");
-				break;
-			case AssignExpr: fprintf(listing, "Assign:\n"); break;
-			case VarAccessExpr: fprintf(listing, "Variable: name = %s\n", tree->name); break;
-			case BinOpExpr:
-				fprintf(listing, "Op: ");
-				printToken(tree->opcode, "");
-				break;
-			case ConstExpr: fprintf(listing, "Const: %d\n", tree->val); break;
-			case CallExpr: fprintf(listing, "Call: function name = %s, type = %s\n", tree->name, TYPE2STR(tree->type)); break;
-			default: fprintf(listing, "Unknown Node Kind : %d (0x%x)\n", tree->kind, tree->kind); break;
-		}
+		case VariableDecl: fprintf(listing, "Variable Declaration: name = %s, type = %s\n", tree->name, TYPE2STR(tree->type)); break;
+		case FunctionDecl: fprintf(listing, "Function Declaration: name = %s, return type = %s\n", tree->name, TYPE2STR(tree->type)); break;
+		case Params:
+			if (tree->flag == TRUE) fprintf(listing, "Void Parameter\n");
+			else
+				fprintf(listing, "Parameter: name = %s, type = %s\n", tree->name, TYPE2STR(tree->type));
+			break;
+		case CompoundStmt: fprintf(listing, "Compound Statement:\n"); break;
+		case IfStmt:
+			if (tree->flag == TRUE) fprintf(listing, "If-Else Statement:\n");
+			else
+				fprintf(listing, "If Statement:\n");
+			break;
+		case WhileStmt: fprintf(listing, "While Statement:\n"); break;
+		case ReturnStmt:
+			if (tree->flag == TRUE) fprintf(listing, "Non-value Return Statement\n");
+			else
+				fprintf(listing, "Return Statement:\n");
+			break;
+		case AssignExpr: fprintf(listing, "Assign:\n"); break;
+		case VarAccessExpr: fprintf(listing, "Variable: name = %s\n", tree->name); break;
+		case BinOpExpr:
+			fprintf(listing, "Op: ");
+			printToken(tree->opcode, "", 0);
+			break;
+		case ConstExpr: fprintf(listing, "Const: %d\n", tree->val); break;
+		case CallExpr: fprintf(listing, "Call: function name = %s, type = %s\n", tree->name, TYPE2STR(tree->type)); break;
+		default: fprintf(listing, "Unknown Node Kind : %d (0x%x)\n", tree->kind, tree->kind); break;
+	}
+}
 
-		for (i = 0; i < MAXCHILDREN; i++) printTree(tree->child[i]);
-		tree = tree->sibling;
+/* endNode unindents after the subtrees of a node;
+ * a body left to be parsed on demand is not asked
+ * for here, only noted
+ */
+static void endNode(TreeNode *tree, void *arg)
+{
+	(void)arg;
+	if (tree->body != NULL)
+	{
+		INDENT;
+		printSpaces();
+		fprintf(listing, "Compound Statement: not parsed yet\n");
+		UNINDENT;
 	}
 	UNINDENT;
 }
+
+/* procedure printTree prints a syntax tree to the
+ * listing file using indentation to indicate subtrees
+ */
+void printTree(TreeNode *tree)
+{
+	if (!walkTree(tree, printNode, endNode, NULL)) fprintf(listing, "Out of memory error at line %d\n", lineno);
+}
@@ -11,9 +11,15 @@
 #include "globals.h"
 
 /* Procedure printToken prints a token
- * and its lexeme to the listing file
+ * and its lexeme (of the given length)
+ * to the listing file
  */
-void printToken(TokenType, const char *);
+void printToken(TokenType, const char *, int);
+
+/* Procedure fprintToken is printToken
+ * writing to out instead of the listing
+ */
+void fprintToken(FILE *, TokenType, const char *, int);
 
 TreeNode* newTreeNode(NodeKind);
 
@@ -32,6 +38,29 @@ TreeNode* newTreeNode(NodeKind);
  */
 char *copyString(char *);
 
+/* Function readSource reads all of file into one
+ * heap buffer followed by two NUL bytes, and its
+ * length into *size; NULL if out of memory
+ */
+char *readSource(FILE *file, size_t *size);
+
+/* Function walkTree visits a syntax tree, its
+ * siblings and all their subtrees in the order a
+ * recursive walk would, calling preProc (unless
+ * NULL) on each node before its subtrees and
+ * postProc (unless NULL) after them, both with arg.
+ * The nodes on the way down are kept on the heap,
+ * so a tree of any depth can be walked, and preProc
+ * may fill in the children of its node. Returns
+ * FALSE if out of memory
+ */
+int walkTree(TreeNode *, void (*preProc)(TreeNode *, void *), void (*postProc)(TreeNode *, void *), void *arg);
+
+/* procedure freeTree releases a syntax tree,
+ * its siblings and all their subtrees
+ */
+void freeTree(TreeNode *);
+
 /* procedure printTree prints a syntax tree to the
  * listing file using indentation to indicate subtrees
  */